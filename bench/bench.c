@@ -0,0 +1,625 @@
+//benchmark harness behind make bench
+//runs every program of the corpus through each engine of brainfck and prints one csv row per run
+//the rows are compared against bench/baseline.csv so wrong output shows up as a failing exit code
+//and against a timing baseline recorded on this machine so slowdowns do too
+
+#include <stdio.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include <stdnoreturn.h>
+#include <stdarg.h>
+#include <ctype.h>
+#include <string.h>
+#include <stdint.h>
+#include <inttypes.h>
+
+#include <errno.h>
+#include <fcntl.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/resource.h>
+#include <sys/stat.h>
+#include <sys/wait.h>
+
+
+#define BENCH_DIR "bench"
+#define WORK_DIR "build/bench"
+//bench/baseline.csv is committed and only holds what every machine agrees on, the op count and output hash of every run
+//wall times and rss only mean something on the machine they were measured on, make bench-baseline records them in build
+#define DEFAULT_EXPECTED BENCH_DIR "/baseline.csv"
+#define DEFAULT_TIMING WORK_DIR "/timing.csv"
+#define DEFAULT_BRAINFCK "bin/brainfck"
+#define DEFAULT_RUNS 3
+#define DEFAULT_THRESHOLD 10.0
+
+#define COUNT_TAPE_SIZE (1 << 20)
+#define MAX_PATH 512
+
+
+typedef struct {
+    const char* name;
+    uint32_t cell_bits;
+    const char* input;        //input file inside bench, NULL for none
+    uint32_t generated_input; //bytes of generated text used as input, 0 for none
+} Program;
+
+Program programs[] = {
+    {"mandelbrot", 32, NULL, 0},
+    {"hanoi", 8, NULL, 0},
+    {"factor", 32, "factor.in", 0},
+    {"loops", 8, NULL, 0},
+    {"output", 8, NULL, 0},
+    {"wc", 32, NULL, 4 << 20},
+};
+
+#define PROGRAM_COUNT (sizeof(programs) / sizeof(programs[0]))
+
+
+typedef enum {
+    ENGINE_INTERPRETER,
+    ENGINE_JIT,
+    ENGINE_COMPILED,
+    ENGINE_COUNT
+} Engine;
+
+const char* engine_names[ENGINE_COUNT] = {"interpreter", "jit", "compiled"};
+
+//the jit only exists on x86_64
+bool engine_supported(Engine engine){
+#if defined(__x86_64__)
+    (void)engine;
+    return true;
+#else
+    return engine != ENGINE_JIT;
+#endif
+}
+
+
+typedef struct {
+    bool ok;
+    uint64_t wall_ns;
+    uint64_t peak_rss_kb;
+    uint64_t output_hash;
+} RunResult;
+
+
+typedef struct {
+    char program[64];
+    char engine[16];
+    uint64_t ops;
+    double wall_ms;
+    uint64_t peak_rss_kb;
+    uint64_t output_hash;
+} BaselineRow;
+
+typedef struct {
+    BaselineRow* data;
+    uint32_t size;
+    uint32_t capacity;
+} Baseline;
+
+
+noreturn void fatal_error(const char* fmt, ...){
+    fprintf(stderr,"Error: ");
+    va_list list;
+    va_start(list, fmt);
+    vfprintf(stderr, fmt, list);
+    va_end(list);
+    exit(EXIT_FAILURE);
+}
+
+
+uint64_t now_ns(){
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ull + ts.tv_nsec;
+}
+
+
+//fnv-1a over everything the program prints
+uint64_t hash_bytes(uint64_t hash, const unsigned char* data, size_t size){
+    for(size_t i = 0; i < size; i++){
+        hash ^= data[i];
+        hash *= 0x100000001b3ull;
+    }
+    return hash;
+}
+
+#define HASH_SEED 0xcbf29ce484222325ull
+
+
+//runs argv with input as stdin and hashes its stdout
+//wall time covers fork to exit, the peak rss comes from the rusage of the child
+RunResult run_command(char** argv, const char* input){
+    RunResult result = {0};
+
+    int out_pipe[2];
+    if(pipe(out_pipe) != 0) fatal_error("Failed to create pipe: %s\n", strerror(errno));
+
+    uint64_t start = now_ns();
+    pid_t pid = fork();
+    if(pid < 0) fatal_error("Failed to fork: %s\n", strerror(errno));
+
+    if(pid == 0){
+        int in = open(input ? input : "/dev/null", O_RDONLY);
+        if(in < 0) _exit(127);
+        dup2(in, STDIN_FILENO);
+        dup2(out_pipe[1], STDOUT_FILENO);
+        close(in);
+        close(out_pipe[0]);
+        close(out_pipe[1]);
+        execv(argv[0], argv);
+        _exit(127);
+    }
+
+    close(out_pipe[1]);
+    uint64_t hash = HASH_SEED;
+    unsigned char buffer[1 << 16];
+    ssize_t count;
+    while((count = read(out_pipe[0], buffer, sizeof(buffer))) != 0){
+        if(count < 0){
+            if(errno == EINTR) continue;
+            break;
+        }
+        hash = hash_bytes(hash, buffer, count);
+    }
+    close(out_pipe[0]);
+
+    int status;
+    struct rusage usage;
+    while(wait4(pid, &status, 0, &usage) < 0){
+        if(errno != EINTR) fatal_error("Failed to wait for %s: %s\n", argv[0], strerror(errno));
+    }
+
+    result.wall_ns = now_ns() - start;
+    result.ok = WIFEXITED(status) && WEXITSTATUS(status) == 0;
+    //ru_maxrss is in kilobytes on linux and in bytes on macos
+#if defined(__APPLE__)
+    result.peak_rss_kb = usage.ru_maxrss / 1024;
+#else
+    result.peak_rss_kb = usage.ru_maxrss;
+#endif
+    result.output_hash = hash;
+    return result;
+}
+
+
+char* read_file(const char* path, size_t* size){
+    FILE* file = fopen(path, "rb");
+    if(!file) fatal_error("Failed to open %s: %s\n", path, strerror(errno));
+    fseek(file, 0, SEEK_END);
+    long length = ftell(file);
+    fseek(file, 0, SEEK_SET);
+    char* data = malloc(length + 1);
+    if(!data) fatal_error("Out of Memory\n");
+    if(fread(data, 1, length, file) != (size_t)length) fatal_error("Failed to read %s\n", path);
+    fclose(file);
+    data[length] = 0;
+    *size = length;
+    return data;
+}
+
+
+//text made of lowercase words and newlines, the same bytes on every run
+void write_generated_input(const char* path, uint32_t size){
+    FILE* file = fopen(path, "wb");
+    if(!file) fatal_error("Failed to create %s: %s\n", path, strerror(errno));
+
+    uint32_t state = 12345;
+    uint32_t word = 0;
+    for(uint32_t i = 0; i < size; i++){
+        state = state * 1103515245u + 12345u;
+        uint32_t r = (state >> 16) & 0x7fff;
+        char c;
+        if(word > 0 && r % 6 == 0){
+            c = (r % 11 == 0) ? '\n' : ' ';
+            word = 0;
+        } else {
+            c = 'a' + r % 26;
+            word++;
+        }
+        fputc(c, file);
+    }
+    fclose(file);
+}
+
+
+typedef struct {
+    char op;
+    uint32_t amount; //run length for + - < > . , and the matching bracket index for [ ]
+    bool simple;     //[ of a loop without io or nested loops that ends on its counter cell
+    int8_t step;     //how a simple loop moves its counter per pass, either 1 or -1
+    uint64_t body;   //instructions a simple loop executes per pass including the ]
+} CountOp;
+
+
+//counts how many brainf*ck instructions a straightforward interpreter executes
+//a run like +++ or a number prefix like 3+ counts as three, so the count does not depend on brainfck's optimizer
+//simple loops are evaluated in closed form, otherwise counting would take hours for some programs
+uint64_t count_ops(const char* source, size_t size, const char* input_path, uint32_t cell_bits){
+    CountOp* ops = malloc(sizeof(CountOp) * (size + 1));
+    uint32_t* stack = malloc(sizeof(uint32_t) * (size + 1));
+    if(!ops || !stack) fatal_error("Out of Memory\n");
+    uint32_t op_count = 0;
+    uint32_t depth = 0;
+    uint64_t number = 0;
+
+    for(size_t i = 0; i < size;){
+        char c = source[i];
+        if(isdigit((unsigned char)c)){
+            while(i < size && isdigit((unsigned char)source[i])){
+                number = number * 10 + (source[i] - '0');
+                if(number > UINT32_MAX) number = UINT32_MAX;
+                i++;
+            }
+            continue;
+        }
+        if(c != 0 && strchr("+-<>.,", c)){
+            size_t end = i + 1;
+            while(end < size && source[end] == c) end++;
+            uint64_t total = (end - i) + (number ? number - 1 : 0);
+            if(c == ',') total = end - i;
+            ops[op_count++] = (CountOp){c, (uint32_t)total, false, 0, 0};
+            number = 0;
+            i = end;
+            continue;
+        }
+        //like brainfck a number only belongs to the next instruction, comments in between keep it
+        if(c == '['){
+            stack[depth++] = op_count;
+            ops[op_count++] = (CountOp){c, 0, false, 0, 0};
+            number = 0;
+        } else if(c == ']'){
+            if(depth == 0) fatal_error("Mismatched Brackets while counting\n");
+            uint32_t open = stack[--depth];
+            ops[open].amount = op_count;
+            ops[op_count++] = (CountOp){c, open, false, 0, 0};
+            number = 0;
+        }
+        i++;
+    }
+    if(depth != 0) fatal_error("No Final Closing Bracket while counting\n");
+
+    //a loop is simple when it only moves and adds, ends on its counter and steps the counter by one
+    for(uint32_t i = 0; i < op_count; i++){
+        if(ops[i].op != '[') continue;
+        int64_t dp = 0;
+        int64_t step = 0;
+        uint64_t body = 1;
+        bool simple = true;
+        for(uint32_t j = i + 1; j < ops[i].amount && simple; j++){
+            body += ops[j].amount;
+            switch(ops[j].op){
+                case '>': dp += ops[j].amount; break;
+                case '<': dp -= ops[j].amount; break;
+                case '+': if(dp == 0) step += ops[j].amount; break;
+                case '-': if(dp == 0) step -= ops[j].amount; break;
+                default: simple = false;
+            }
+        }
+        ops[i].simple = simple && dp == 0 && (step == 1 || step == -1);
+        ops[i].step = step;
+        ops[i].body = body;
+    }
+
+    //the tape and input are mapped rather than allocated so none of it stays resident in the harness
+    //every child starts as a copy of the harness and that copy counts towards its peak rss
+    size_t input_size = 0;
+    char* input = NULL;
+    if(input_path){
+        int fd = open(input_path, O_RDONLY);
+        struct stat st;
+        if(fd < 0 || fstat(fd, &st) != 0) fatal_error("Failed to open %s: %s\n", input_path, strerror(errno));
+        input_size = st.st_size;
+        if(input_size > 0){
+            input = mmap(NULL, input_size, PROT_READ, MAP_PRIVATE, fd, 0);
+            if(input == MAP_FAILED) fatal_error("Failed to map %s: %s\n", input_path, strerror(errno));
+        }
+        close(fd);
+    }
+    size_t input_pos = 0;
+
+    uint32_t mask = cell_bits == 32 ? UINT32_MAX : (1u << cell_bits) - 1;
+    size_t tape_bytes = COUNT_TAPE_SIZE * sizeof(uint32_t);
+    uint32_t* tape = mmap(NULL, tape_bytes, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if(tape == MAP_FAILED) fatal_error("Out of Memory\n");
+    int64_t dp = COUNT_TAPE_SIZE / 2;
+    uint64_t count = 0;
+
+    for(uint32_t ip = 0; ip < op_count; ip++){
+        CountOp op = ops[ip];
+        switch(op.op){
+            case '>': dp += op.amount; count += op.amount; break;
+            case '<': dp -= op.amount; count += op.amount; break;
+            case '+': tape[dp] = (tape[dp] + op.amount) & mask; count += op.amount; break;
+            case '-': tape[dp] = (tape[dp] - op.amount) & mask; count += op.amount; break;
+            case '.': count += op.amount; break;
+            case ',':
+                //only one byte is read, like brainfck, and end of input stores -1 like the interpreter
+                tape[dp] = input_pos < input_size ? (unsigned char)input[input_pos++] : mask;
+                count += op.amount;
+                break;
+            case '[':
+                count++;
+                if(tape[dp] == 0){
+                    ip = op.amount;
+                    break;
+                }
+                if(!op.simple) break;
+                {
+                    //the counter hits zero after value passes when counting down and after -value passes when counting up
+                    uint64_t iterations = op.step < 0 ? tape[dp] : (uint64_t)mask + 1 - tape[dp];
+                    int64_t rel = 0;
+                    for(uint32_t j = ip + 1; j < op.amount; j++){
+                        CountOp inner = ops[j];
+                        if(inner.op == '>') rel += inner.amount;
+                        else if(inner.op == '<') rel -= inner.amount;
+                        else if(rel != 0){
+                            if(dp + rel < 0 || dp + rel >= COUNT_TAPE_SIZE) fatal_error("Tape overflow while counting\n");
+                            uint64_t delta = (uint64_t)inner.amount * iterations;
+                            if(inner.op == '+') tape[dp + rel] = (tape[dp + rel] + delta) & mask;
+                            else tape[dp + rel] = (tape[dp + rel] - delta) & mask;
+                        }
+                    }
+                    tape[dp] = 0;
+                    count += iterations * op.body;
+                    ip = op.amount;
+                }
+                break;
+            case ']':
+                count++;
+                if(tape[dp] != 0) ip = op.amount;
+                break;
+        }
+        if(dp < 0 || dp >= COUNT_TAPE_SIZE) fatal_error("Tape overflow while counting\n");
+    }
+
+    munmap(tape, tape_bytes);
+    if(input) munmap(input, input_size);
+    free(stack);
+    free(ops);
+    return count;
+}
+
+
+void baseline_append(Baseline* baseline, BaselineRow row){
+    if(baseline->size == baseline->capacity){
+        baseline->capacity = baseline->capacity ? baseline->capacity * 2 : 16;
+        baseline->data = realloc(baseline->data, sizeof(BaselineRow) * baseline->capacity);
+        if(!baseline->data) fatal_error("Out of Memory\n");
+    }
+    baseline->data[baseline->size++] = row;
+}
+
+
+BaselineRow* baseline_find(Baseline* baseline, const char* program, const char* engine){
+    for(uint32_t i = 0; i < baseline->size; i++){
+        BaselineRow* row = &baseline->data[i];
+        if(strcmp(row->program, program) == 0 && (!engine || strcmp(row->engine, engine) == 0)) return row;
+    }
+    return NULL;
+}
+
+
+//a missing baseline is not an error, every row is reported as new instead
+//timing baselines hold wall_ms and peak_rss_kb, the others ops and output_hash
+Baseline baseline_load(const char* path, bool timing){
+    Baseline baseline = {0};
+    FILE* file = fopen(path, "r");
+    if(!file) return baseline;
+
+    char line[256];
+    uint32_t line_number = 0;
+    while(fgets(line, sizeof(line), file)){
+        line_number++;
+        if(line_number == 1 || line[0] == '\n') continue;
+        BaselineRow row = {0};
+        int fields;
+        if(timing) fields = sscanf(line, "%63[^,],%15[^,],%lf,%" SCNu64, row.program, row.engine, &row.wall_ms, &row.peak_rss_kb);
+        else fields = sscanf(line, "%63[^,],%15[^,],%" SCNu64 ",%" SCNx64, row.program, row.engine, &row.ops, &row.output_hash);
+        if(fields != 4) fatal_error("Malformed baseline %s\nLine %u: %s", path, line_number, line);
+        baseline_append(&baseline, row);
+    }
+    fclose(file);
+    return baseline;
+}
+
+
+void baseline_save(const char* path, Baseline* baseline, bool timing){
+    FILE* file = fopen(path, "w");
+    if(!file) fatal_error("Failed to write %s: %s\n", path, strerror(errno));
+    fprintf(file, timing ? "program,engine,wall_ms,peak_rss_kb\n" : "program,engine,ops,output_hash\n");
+    for(uint32_t i = 0; i < baseline->size; i++){
+        BaselineRow* row = &baseline->data[i];
+        if(timing) fprintf(file, "%s,%s,%.1f,%" PRIu64 "\n", row->program, row->engine, row->wall_ms, row->peak_rss_kb);
+        else fprintf(file, "%s,%s,%" PRIu64 ",%016" PRIx64 "\n", row->program, row->engine, row->ops, row->output_hash);
+    }
+    fclose(file);
+}
+
+
+//programs and engines that were not run keep their old rows
+void baseline_merge(Baseline* baseline, Baseline* measured){
+    for(uint32_t i = 0; i < measured->size; i++){
+        BaselineRow* row = baseline_find(baseline, measured->data[i].program, measured->data[i].engine);
+        if(row) *row = measured->data[i];
+        else baseline_append(baseline, measured->data[i]);
+    }
+}
+
+
+void usage(){
+    fprintf(stderr, "bench [options] [program...]\n");
+    fprintf(stderr, "--update            record this run as the timing baseline of this machine\n");
+    fprintf(stderr, "--update-expected   record the op counts and output hashes of this run in %s\n", DEFAULT_EXPECTED);
+    fprintf(stderr, "--runs {n}          runs per program and engine, the fastest counts (default %d)\n", DEFAULT_RUNS);
+    fprintf(stderr, "--threshold {pct}   change in wall time reported as slower or faster (default %.0f)\n", DEFAULT_THRESHOLD);
+    fprintf(stderr, "--baseline {file}   timing baseline to compare against (default %s)\n", DEFAULT_TIMING);
+    fprintf(stderr, "--expected {file}   op counts and output hashes to check against (default %s)\n", DEFAULT_EXPECTED);
+    fprintf(stderr, "--brainfck {path}   brainfck binary to measure (default %s)\n", DEFAULT_BRAINFCK);
+}
+
+
+int main(int argc, char** argv){
+    const char* timing_path = DEFAULT_TIMING;
+    const char* expected_path = DEFAULT_EXPECTED;
+    char* brainfck = DEFAULT_BRAINFCK;
+    uint32_t runs = DEFAULT_RUNS;
+    double threshold = DEFAULT_THRESHOLD;
+    bool update = false;
+    bool update_expected = false;
+    bool selected[PROGRAM_COUNT] = {0};
+    bool any_selected = false;
+
+    for(int i = 1; i < argc; i++){
+        char* arg = argv[i];
+        if(strcmp(arg, "--update") == 0){
+            update = true;
+        } else if(strcmp(arg, "--update-expected") == 0){
+            update_expected = true;
+        } else if(strcmp(arg, "--runs") == 0 && i + 1 < argc){
+            runs = strtoul(argv[++i], NULL, 10);
+            if(runs == 0) fatal_error("--runs needs at least one run\n");
+        } else if(strcmp(arg, "--threshold") == 0 && i + 1 < argc){
+            threshold = strtod(argv[++i], NULL);
+        } else if(strcmp(arg, "--baseline") == 0 && i + 1 < argc){
+            timing_path = argv[++i];
+        } else if(strcmp(arg, "--expected") == 0 && i + 1 < argc){
+            expected_path = argv[++i];
+        } else if(strcmp(arg, "--brainfck") == 0 && i + 1 < argc){
+            brainfck = argv[++i];
+        } else if(arg[0] == '-'){
+            usage();
+            return 1;
+        } else {
+            uint32_t p = 0;
+            while(p < PROGRAM_COUNT && strcmp(programs[p].name, arg) != 0) p++;
+            if(p == PROGRAM_COUNT) fatal_error("Unknown benchmark %s\n", arg);
+            selected[p] = true;
+            any_selected = true;
+        }
+    }
+
+    if(access(brainfck, X_OK) != 0) fatal_error("%s is not built, run make first\n", brainfck);
+    mkdir("build", 0755);
+    mkdir(WORK_DIR, 0755);
+
+    Baseline expected = baseline_load(expected_path, false);
+    Baseline timing = baseline_load(timing_path, true);
+    Baseline measured = {0};
+    bool failed = false;
+    if(timing.size == 0 && !update) fprintf(stderr, "No timing baseline in %s, run make bench-baseline to compare wall times\n", timing_path);
+
+    printf("program,engine,wall_ms,ops,ops_per_sec,peak_rss_kb,output_hash,baseline_wall_ms,change_pct,status\n");
+    fflush(stdout);
+
+    for(uint32_t p = 0; p < PROGRAM_COUNT; p++){
+        Program* program = &programs[p];
+        if(any_selected && !selected[p]) continue;
+
+        char source[MAX_PATH], input[MAX_PATH], executable[MAX_PATH], cell_bits[16];
+        snprintf(source, MAX_PATH, BENCH_DIR "/%s.bf", program->name);
+        snprintf(executable, MAX_PATH, WORK_DIR "/%s", program->name);
+        snprintf(cell_bits, sizeof(cell_bits), "%u", program->cell_bits);
+        const char* input_path = NULL;
+        if(program->input){
+            snprintf(input, MAX_PATH, BENCH_DIR "/%s", program->input);
+            input_path = input;
+        } else if(program->generated_input){
+            snprintf(input, MAX_PATH, WORK_DIR "/%s.in", program->name);
+            write_generated_input(input, program->generated_input);
+            input_path = input;
+        }
+
+        //the op count only depends on the program and its input so it is kept in the baseline
+        BaselineRow* known = baseline_find(&expected, program->name, NULL);
+        uint64_t ops;
+        if(known && !update_expected){
+            ops = known->ops;
+        } else {
+            size_t size;
+            char* code = read_file(source, &size);
+            ops = count_ops(code, size, input_path, program->cell_bits);
+            free(code);
+        }
+
+        char* compile_argv[] = {brainfck, "--cell-bits", cell_bits, "-o", executable, source, NULL};
+        bool compiled = run_command(compile_argv, NULL).ok;
+
+        for(Engine engine = 0; engine < ENGINE_COUNT; engine++){
+            if(!engine_supported(engine)) continue;
+
+            char* interpreter_argv[] = {brainfck, "--cell-bits", cell_bits, source, NULL};
+            char* jit_argv[] = {brainfck, "--jit", "--cell-bits", cell_bits, source, NULL};
+            char* compiled_argv[] = {executable, NULL};
+            char** run_argv = engine == ENGINE_INTERPRETER ? interpreter_argv : engine == ENGINE_JIT ? jit_argv : compiled_argv;
+
+            RunResult best = {0};
+            bool ok = engine != ENGINE_COMPILED || compiled;
+            for(uint32_t r = 0; r < runs && ok; r++){
+                RunResult result = run_command(run_argv, input_path);
+                ok = result.ok && (r == 0 || result.output_hash == best.output_hash);
+                if(r == 0 || result.wall_ns < best.wall_ns) best.wall_ns = result.wall_ns;
+                if(result.peak_rss_kb > best.peak_rss_kb) best.peak_rss_kb = result.peak_rss_kb;
+                best.output_hash = result.output_hash;
+            }
+
+            double wall_ms = best.wall_ns / 1e6;
+            double ops_per_sec = best.wall_ns ? ops / (best.wall_ns / 1e9) : 0;
+            BaselineRow* correct = baseline_find(&expected, program->name, engine_names[engine]);
+            BaselineRow* previous = baseline_find(&timing, program->name, engine_names[engine]);
+
+            //untimed runs printed the expected output but there is no wall time from this machine to compare with
+            const char* status;
+            double change = 0;
+            if(!ok){
+                status = "failed";
+                failed = true;
+            } else if(correct && correct->output_hash != best.output_hash){
+                status = "wrong";
+                if(!update_expected) failed = true;
+            } else if(!previous){
+                status = correct ? "untimed" : "new";
+            } else {
+                change = (wall_ms - previous->wall_ms) / previous->wall_ms * 100.0;
+                if(change > threshold) status = "slower";
+                else if(change < -threshold) status = "faster";
+                else status = "ok";
+                if(!update && strcmp(status, "slower") == 0) failed = true;
+            }
+
+            printf("%s,%s,%.1f,%" PRIu64 ",%.0f,%" PRIu64 ",%016" PRIx64 ",", program->name, engine_names[engine],
+                    wall_ms, ops, ops_per_sec, best.peak_rss_kb, best.output_hash);
+            if(previous) printf("%.1f,%.1f,%s\n", previous->wall_ms, change, status);
+            else printf(",,%s\n", status);
+            fflush(stdout);
+
+            if(ok){
+                BaselineRow row = {0};
+                snprintf(row.program, sizeof(row.program), "%s", program->name);
+                snprintf(row.engine, sizeof(row.engine), "%s", engine_names[engine]);
+                row.ops = ops;
+                row.wall_ms = wall_ms;
+                row.peak_rss_kb = best.peak_rss_kb;
+                row.output_hash = best.output_hash;
+                baseline_append(&measured, row);
+            }
+        }
+    }
+
+    if(update_expected){
+        if(failed) fatal_error("Not updating %s, some runs failed\n", expected_path);
+        baseline_merge(&expected, &measured);
+        baseline_save(expected_path, &expected, false);
+        fprintf(stderr, "Updated %s\n", expected_path);
+    }
+    if(update){
+        if(failed) fatal_error("Not updating %s, some runs failed\n", timing_path);
+        baseline_merge(&timing, &measured);
+        baseline_save(timing_path, &timing, true);
+        fprintf(stderr, "Updated %s\n", timing_path);
+    }
+
+    return failed ? 1 : 0;
+}
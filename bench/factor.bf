@@ -0,0 +1,275 @@
+Factor
+Reads one number per line and prints its prime factors like the factor tool
+a line holding zero ends the input
+
+>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>+[<<<+[<<<<<<<<<<<
+<<<<,>>>>>>>>>+>>>+<<<<<<<<<<<<[->>>>>>+<<<+<<<]>>>>>>[-<<<<<<+>
+>>>>>]<<<---------->+<[>-]>[-<>>>>>>-<<<<<<>>]<<++++++++++[-]>>>
+>>>[>>>-<<<<<<<<<<<<--------------------------------------------
+----<<<[->>>>>>>>>++++++++++<<<<<<<<<]>>>>>>>>>[-<<<<<<<<<+>>>>>
+>>>>]<<<<<<[-<<<+>>>]>>>>>>>>>[-]]>>>[<<<<<<<<<<<<---------->>>>
+>>>>>>>>>>>-<<<[-]]>>>]>>>[-]<<<<<<<<<<<<<<<<<<<<<[->>>>>>>>>+<<
+<+<<<<<<]>>>>>>>>>[-<<<<<<<<<+>>>>>>>>>]<<<[>>>>>>>>>>>>>>>+<<<<
+<<<<<<<<<<<[-]]>>>>>>>>>>>>>>>[-<<<<<<<<<<<<+>>>>>>>>>>>>>>>>>>>
+>>>>>>>>>>>+<<<<<<<<<<<<<<<<<<]<<<<<<<<<<<<[->>>>>>>>>>>>+<<<<<<
+<<<<<<]>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>[<<<<<<<<<<<<<<<<<<<<<<<<<<
+<<<<<<<<<<<<<[-<<<<<<<<<<<<<<<<<<<+<<<<<<+>>>>>>>>>>>>>>>>>>>>>>
+>>>]<<<<<<<<<<<<<<<<<<<[->>>>>>>>>>>>>>>>>>>+<<<<<<<<<<<<<<<<<<<
+]<<<<<++++++++++<[->-[>+>>]>[+[-<+>]>+>>]<<<<<]>>[->>>>>>>>>>+<<
+<<<<<<<<<+>]<---------->>[-<<<+>>>]<<++++++++++<[->-[>+>>]>[+[-<
++>]>+>>]<<<<<]>>[->>>>>>>>>>>+<<<<<<<<<<<<+>]<---------->>[-<<<+
+>>>]<<++++++++++<[->-[>+>>]>[+[-<+>]>+>>]<<<<<]>>[->>>>>>>>>>>>+
+<<<<<<<<<<<<<+>]<---------->>[-<<<+>>>]<<++++++++++<[->-[>+>>]>[
++[-<+>]>+>>]<<<<<]>>[->>>>>>>>>>>>>+<<<<<<<<<<<<<<+>]<----------
+>>[-<<<+>>>]<<++++++++++<[->-[>+>>]>[+[-<+>]>+>>]<<<<<]>>[->>>>>
+>>>>>>>>>+<<<<<<<<<<<<<<<+>]<---------->>[-<<<+>>>]<<++++++++++<
+[->-[>+>>]>[+[-<+>]>+>>]<<<<<]>>[->>>>>>>>>>>>>>>+<<<<<<<<<<<<<<
+<<+>]<---------->>[-<<<+>>>]<<++++++++++<[->-[>+>>]>[+[-<+>]>+>>
+]<<<<<]>>[->>>>>>>>>>>>>>>>+<<<<<<<<<<<<<<<<<+>]<---------->>[-<
+<<+>>>]<<++++++++++<[->-[>+>>]>[+[-<+>]>+>>]<<<<<]>>[->>>>>>>>>>
+>>>>>>>+<<<<<<<<<<<<<<<<<<+>]<---------->>[-<<<+>>>]<<++++++++++
+<[->-[>+>>]>[+[-<+>]>+>>]<<<<<]>>[->>>>>>>>>>>>>>>>>>+<<<<<<<<<<
+<<<<<<<<<+>]<---------->>[-<<<+>>>]<<++++++++++<[->-[>+>>]>[+[-<
++>]>+>>]<<<<<]>>[->>>>>>>>>>>>>>>>>>>+<<<<<<<<<<<<<<<<<<<<+>]<--
+-------->>[-<<<+>>>]<<<[-]>>>>>>>>>>>>>>>>>>>>>[-<<<<<<<<<<<<<<<
++>>>>>>>>>>>>>>>>>+<<]<<<<<<<<<<<<<<<[->>>>>>>>>>>>>>>+<<<<<<<<<
+<<<<<<]>>>>>>>>>>>>>>>>>[<[-]+>[-]]<[-<<<<<<<<<<<<<<<<+>>>>>>>>>
+>>>>>>>>+<]<<<<<<<<<<<<<<<<[->>>>>>>>>>>>>>>>+<<<<<<<<<<<<<<<<]>
+>>>>>>>>>>>>>>>>[<<+++++++++++++++++++++++++++++++++++++++++++++
++++.------------------------------------------------>>[-]]<<[-]<
+[-<<<<<<<<<<<<<<+>>>>>>>>>>>>>>>>>+<<<]<<<<<<<<<<<<<<[->>>>>>>>>
+>>>>>+<<<<<<<<<<<<<<]>>>>>>>>>>>>>>>>>[<[-]+>[-]]<[-<<<<<<<<<<<<
+<<<<+>>>>>>>>>>>>>>>>>+<]<<<<<<<<<<<<<<<<[->>>>>>>>>>>>>>>>+<<<<
+<<<<<<<<<<<<]>>>>>>>>>>>>>>>>>[<<<++++++++++++++++++++++++++++++
+++++++++++++++++++.---------------------------------------------
+--->>>[-]]<<<[-]<[-<<<<<<<<<<<<<+>>>>>>>>>>>>>>>>>+<<<<]<<<<<<<<
+<<<<<[->>>>>>>>>>>>>+<<<<<<<<<<<<<]>>>>>>>>>>>>>>>>>[<[-]+>[-]]<
+[-<<<<<<<<<<<<<<<<+>>>>>>>>>>>>>>>>>+<]<<<<<<<<<<<<<<<<[->>>>>>>
+>>>>>>>>>+<<<<<<<<<<<<<<<<]>>>>>>>>>>>>>>>>>[<<<<+++++++++++++++
++++++++++++++++++++++++++++++++++.------------------------------
+------------------>>>>[-]]<<<<[-]<[-<<<<<<<<<<<<+>>>>>>>>>>>>>>>
+>>+<<<<<]<<<<<<<<<<<<[->>>>>>>>>>>>+<<<<<<<<<<<<]>>>>>>>>>>>>>>>
+>>[<[-]+>[-]]<[-<<<<<<<<<<<<<<<<+>>>>>>>>>>>>>>>>>+<]<<<<<<<<<<<
+<<<<<[->>>>>>>>>>>>>>>>+<<<<<<<<<<<<<<<<]>>>>>>>>>>>>>>>>>[<<<<<
+++++++++++++++++++++++++++++++++++++++++++++++++.---------------
+--------------------------------->>>>>[-]]<<<<<[-]<[-<<<<<<<<<<<
++>>>>>>>>>>>>>>>>>+<<<<<<]<<<<<<<<<<<[->>>>>>>>>>>+<<<<<<<<<<<]>
+>>>>>>>>>>>>>>>>[<[-]+>[-]]<[-<<<<<<<<<<<<<<<<+>>>>>>>>>>>>>>>>>
++<]<<<<<<<<<<<<<<<<[->>>>>>>>>>>>>>>>+<<<<<<<<<<<<<<<<]>>>>>>>>>
+>>>>>>>>[<<<<<<++++++++++++++++++++++++++++++++++++++++++++++++.
+------------------------------------------------>>>>>>[-]]<<<<<<
+[-]<[-<<<<<<<<<<+>>>>>>>>>>>>>>>>>+<<<<<<<]<<<<<<<<<<[->>>>>>>>>
+>+<<<<<<<<<<]>>>>>>>>>>>>>>>>>[<[-]+>[-]]<[-<<<<<<<<<<<<<<<<+>>>
+>>>>>>>>>>>>>>+<]<<<<<<<<<<<<<<<<[->>>>>>>>>>>>>>>>+<<<<<<<<<<<<
+<<<<]>>>>>>>>>>>>>>>>>[<<<<<<<++++++++++++++++++++++++++++++++++
+++++++++++++++.------------------------------------------------>
+>>>>>>[-]]<<<<<<<[-]<[-<<<<<<<<<+>>>>>>>>>>>>>>>>>+<<<<<<<<]<<<<
+<<<<<[->>>>>>>>>+<<<<<<<<<]>>>>>>>>>>>>>>>>>[<[-]+>[-]]<[-<<<<<<
+<<<<<<<<<<+>>>>>>>>>>>>>>>>>+<]<<<<<<<<<<<<<<<<[->>>>>>>>>>>>>>>
+>+<<<<<<<<<<<<<<<<]>>>>>>>>>>>>>>>>>[<<<<<<<<+++++++++++++++++++
++++++++++++++++++++++++++++++.----------------------------------
+-------------->>>>>>>>[-]]<<<<<<<<[-]<[-<<<<<<<<+>>>>>>>>>>>>>>>
+>>+<<<<<<<<<]<<<<<<<<[->>>>>>>>+<<<<<<<<]>>>>>>>>>>>>>>>>>[<[-]+
+>[-]]<[-<<<<<<<<<<<<<<<<+>>>>>>>>>>>>>>>>>+<]<<<<<<<<<<<<<<<<[->
+>>>>>>>>>>>>>>>+<<<<<<<<<<<<<<<<]>>>>>>>>>>>>>>>>>[<<<<<<<<<++++
+++++++++++++++++++++++++++++++++++++++++++++.-------------------
+----------------------------->>>>>>>>>[-]]<<<<<<<<<[-]<[-<<<<<<<
++>>>>>>>>>>>>>>>>>+<<<<<<<<<<]<<<<<<<[->>>>>>>+<<<<<<<]>>>>>>>>>
+>>>>>>>>[<[-]+>[-]]<[-<<<<<<<<<<<<<<<<+>>>>>>>>>>>>>>>>>+<]<<<<<
+<<<<<<<<<<<[->>>>>>>>>>>>>>>>+<<<<<<<<<<<<<<<<]>>>>>>>>>>>>>>>>>
+[<<<<<<<<<<++++++++++++++++++++++++++++++++++++++++++++++++.----
+-------------------------------------------->>>>>>>>>>[-]]<<<<<<
+<<<<[-]>>>>>>>>>[-]+[-<<<<<<<<<<<<<<<<+>>>>>>>>>>>>>>>>>+<]<<<<<
+<<<<<<<<<<<[->>>>>>>>>>>>>>>>+<<<<<<<<<<<<<<<<]>>>>>>>>>>>>>>>>>
+[<<<<<<<<<<<++++++++++++++++++++++++++++++++++++++++++++++++.---
+--------------------------------------------->>>>>>>>>>>[-]]<<<<
+<<<<<<<[-]>>>>>>>>>>[-]>>+++++++++++++++++++++++++++++++++++++++
++++++++++++++++++++.--------------------------------------------
+-------------->>>>>>>>>>>>>>>>>>>>>>>>>++>>>>>>>>>>>>>>>>>>>>>>>
+>+[<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<[->>>>>>>>>+<
+<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<+>>>>>>>>>>>>>>>>>>>>>>>>>]>>>>
+>>>>>[-<<<<<<<<<+>>>>>>>>>]>>>>>>>>>>>>>>>[-<<<<<<<<<<<<<<<+<<<<
+<<<<<<<<<<<<<<<<<<<<<<<<<<<<<+>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+>>>>>>>>>>>>>>]<<<<<<<<<<<<<<<[->>>>>>>>>>>>>>>+<<<<<<<<<<<<<<<]
+<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<[->-[>+>>]>[+[-<+>]>+>>]<<<<<]
+>>[->>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>+<<<<<<
+<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<+>]>>>>>>>>>>>>>
+>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>[-<<<<<<<<<<<<<<<+<<<<<<<<<<<<
+<<<<<<<<<<<<<<<<<<<<<->>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+>>>>>>]<<<<<<<<<<<<<<<[->>>>>>>>>>>>>>>+<<<<<<<<<<<<<<<]<<<<<<<<
+<<<<<<<<<<<<<<<<<<<<<<<[->>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+>>>>>>>>>>+<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<]>>>
+>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>[-<<<<<<<<<<<<<<<<
+<<+>>>>>>>>>>>>>>>>>>>>>>>>+<<<<<<]<<<<<<<<<<<<<<<<<<[->>>>>>>>>
+>>>>>>>>>+<<<<<<<<<<<<<<<<<<]>>>>>>>>>>>>>>>[-<<<<<<<<<<<<<<<+>>
+>>>>>>>>>>>>>>>>>>>>>>>>>+<<<<<<<<<<<<]<<<<<<<<<<<<<<<[->>>>>>>>
+>>>>>>>+<<<<<<<<<<<<<<<]>>>>>>>>>+[>>>>>>>>>>>>>>>>>>>>>+<<<>+<[
+>-]>[-<<<<<<<<<<<<<<<<<<<->>>>>>>>>>>>>>>>>>>>>-<<<>>]<<>>>[>>>+
+<<<<<<<<<>+<[>-]>[-<>>>>>>>>>>>>+<<<<<<<<<<<<<<<<<<<<<<<<<<<->>>
+>>>>>>>>>>>>>>>>>>>>>-<<<<<<<<<>>]<<>>>>>>>>>[<<<<<<<<<->>>->>>>
+>>[-]]<<<[-]]<<<<<<<<<<<<<<<<<<<<<]>>>>>>>>>>>>>>>[-]>>>[-]>>>>>
+>>>>>>>[-]+<<<[>>>-<<<[-]]>>>[-<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+<<<<<<+>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>+>>>>>>>>>]<<<<<<<<<<<<<<<<
+<<<<<<<<<<<<<<<<<<<<<<<[->>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
++<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<]>>>>>>>>>>>>>>>>>>>>>>>
+>>>>>>>[>>>+<<<<<<<<<<<<[-<<<<<<<<<<<<<<<<<<<<<+<<<+>>>>>>>>>>>>
+>>>>>>>>>>>>]<<<<<<<<<<<<<<<<<<<<<[->>>>>>>>>>>>>>>>>>>>>+<<<<<<
+<<<<<<<<<<<<<<<]<<<[>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>-<<<<<<<
+<<<<<<<<<<<+<<<<<<<<<<<<<<<<<<[-]]>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+>>>>>>[<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<++++++++++++++
+++++++++++++++++++.-------------------------------->>>>>>>>>>>>>
+>>>>>>>>>>>>[-<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<+<<<<<<
++>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>]<<<<<<<<<<<<<
+<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<[->>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+>>>>>>>>>>>+<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<]<<<<<+++
++++++++<[->-[>+>>]>[+[-<+>]>+>>]<<<<<]>>[->>>>>>>>>>+<<<<<<<<<<<
++>]<---------->>[-<<<+>>>]<<++++++++++<[->-[>+>>]>[+[-<+>]>+>>]<
+<<<<]>>[->>>>>>>>>>>+<<<<<<<<<<<<+>]<---------->>[-<<<+>>>]<<+++
++++++++<[->-[>+>>]>[+[-<+>]>+>>]<<<<<]>>[->>>>>>>>>>>>+<<<<<<<<<
+<<<<+>]<---------->>[-<<<+>>>]<<++++++++++<[->-[>+>>]>[+[-<+>]>+
+>>]<<<<<]>>[->>>>>>>>>>>>>+<<<<<<<<<<<<<<+>]<---------->>[-<<<+>
+>>]<<++++++++++<[->-[>+>>]>[+[-<+>]>+>>]<<<<<]>>[->>>>>>>>>>>>>>
++<<<<<<<<<<<<<<<+>]<---------->>[-<<<+>>>]<<++++++++++<[->-[>+>>
+]>[+[-<+>]>+>>]<<<<<]>>[->>>>>>>>>>>>>>>+<<<<<<<<<<<<<<<<+>]<---
+------->>[-<<<+>>>]<<++++++++++<[->-[>+>>]>[+[-<+>]>+>>]<<<<<]>>
+[->>>>>>>>>>>>>>>>+<<<<<<<<<<<<<<<<<+>]<---------->>[-<<<+>>>]<<
+++++++++++<[->-[>+>>]>[+[-<+>]>+>>]<<<<<]>>[->>>>>>>>>>>>>>>>>+<
+<<<<<<<<<<<<<<<<<+>]<---------->>[-<<<+>>>]<<++++++++++<[->-[>+>
+>]>[+[-<+>]>+>>]<<<<<]>>[->>>>>>>>>>>>>>>>>>+<<<<<<<<<<<<<<<<<<<
++>]<---------->>[-<<<+>>>]<<++++++++++<[->-[>+>>]>[+[-<+>]>+>>]<
+<<<<]>>[->>>>>>>>>>>>>>>>>>>+<<<<<<<<<<<<<<<<<<<<+>]<---------->
+>[-<<<+>>>]<<<[-]>>>>>>>>>>>>>>>>>>>>>[-<<<<<<<<<<<<<<<+>>>>>>>>
+>>>>>>>>>+<<]<<<<<<<<<<<<<<<[->>>>>>>>>>>>>>>+<<<<<<<<<<<<<<<]>>
+>>>>>>>>>>>>>>>[<[-]+>[-]]<[-<<<<<<<<<<<<<<<<+>>>>>>>>>>>>>>>>>+
+<]<<<<<<<<<<<<<<<<[->>>>>>>>>>>>>>>>+<<<<<<<<<<<<<<<<]>>>>>>>>>>
+>>>>>>>[<<++++++++++++++++++++++++++++++++++++++++++++++++.-----
+------------------------------------------->>[-]]<<[-]<[-<<<<<<<
+<<<<<<<+>>>>>>>>>>>>>>>>>+<<<]<<<<<<<<<<<<<<[->>>>>>>>>>>>>>+<<<
+<<<<<<<<<<<]>>>>>>>>>>>>>>>>>[<[-]+>[-]]<[-<<<<<<<<<<<<<<<<+>>>>
+>>>>>>>>>>>>>+<]<<<<<<<<<<<<<<<<[->>>>>>>>>>>>>>>>+<<<<<<<<<<<<<
+<<<]>>>>>>>>>>>>>>>>>[<<<+++++++++++++++++++++++++++++++++++++++
++++++++++.------------------------------------------------>>>[-]
+]<<<[-]<[-<<<<<<<<<<<<<+>>>>>>>>>>>>>>>>>+<<<<]<<<<<<<<<<<<<[->>
+>>>>>>>>>>>+<<<<<<<<<<<<<]>>>>>>>>>>>>>>>>>[<[-]+>[-]]<[-<<<<<<<
+<<<<<<<<<+>>>>>>>>>>>>>>>>>+<]<<<<<<<<<<<<<<<<[->>>>>>>>>>>>>>>>
++<<<<<<<<<<<<<<<<]>>>>>>>>>>>>>>>>>[<<<<++++++++++++++++++++++++
+++++++++++++++++++++++++.---------------------------------------
+--------->>>>[-]]<<<<[-]<[-<<<<<<<<<<<<+>>>>>>>>>>>>>>>>>+<<<<<]
+<<<<<<<<<<<<[->>>>>>>>>>>>+<<<<<<<<<<<<]>>>>>>>>>>>>>>>>>[<[-]+>
+[-]]<[-<<<<<<<<<<<<<<<<+>>>>>>>>>>>>>>>>>+<]<<<<<<<<<<<<<<<<[->>
+>>>>>>>>>>>>>>+<<<<<<<<<<<<<<<<]>>>>>>>>>>>>>>>>>[<<<<<+++++++++
++++++++++++++++++++++++++++++++++++++++.------------------------
+------------------------>>>>>[-]]<<<<<[-]<[-<<<<<<<<<<<+>>>>>>>>
+>>>>>>>>>+<<<<<<]<<<<<<<<<<<[->>>>>>>>>>>+<<<<<<<<<<<]>>>>>>>>>>
+>>>>>>>[<[-]+>[-]]<[-<<<<<<<<<<<<<<<<+>>>>>>>>>>>>>>>>>+<]<<<<<<
+<<<<<<<<<<[->>>>>>>>>>>>>>>>+<<<<<<<<<<<<<<<<]>>>>>>>>>>>>>>>>>[
+<<<<<<++++++++++++++++++++++++++++++++++++++++++++++++.---------
+--------------------------------------->>>>>>[-]]<<<<<<[-]<[-<<<
+<<<<<<<+>>>>>>>>>>>>>>>>>+<<<<<<<]<<<<<<<<<<[->>>>>>>>>>+<<<<<<<
+<<<]>>>>>>>>>>>>>>>>>[<[-]+>[-]]<[-<<<<<<<<<<<<<<<<+>>>>>>>>>>>>
+>>>>>+<]<<<<<<<<<<<<<<<<[->>>>>>>>>>>>>>>>+<<<<<<<<<<<<<<<<]>>>>
+>>>>>>>>>>>>>[<<<<<<<+++++++++++++++++++++++++++++++++++++++++++
++++++.------------------------------------------------>>>>>>>[-]
+]<<<<<<<[-]<[-<<<<<<<<<+>>>>>>>>>>>>>>>>>+<<<<<<<<]<<<<<<<<<[->>
+>>>>>>>+<<<<<<<<<]>>>>>>>>>>>>>>>>>[<[-]+>[-]]<[-<<<<<<<<<<<<<<<
+<+>>>>>>>>>>>>>>>>>+<]<<<<<<<<<<<<<<<<[->>>>>>>>>>>>>>>>+<<<<<<<
+<<<<<<<<<]>>>>>>>>>>>>>>>>>[<<<<<<<<++++++++++++++++++++++++++++
+++++++++++++++++++++.-------------------------------------------
+----->>>>>>>>[-]]<<<<<<<<[-]<[-<<<<<<<<+>>>>>>>>>>>>>>>>>+<<<<<<
+<<<]<<<<<<<<[->>>>>>>>+<<<<<<<<]>>>>>>>>>>>>>>>>>[<[-]+>[-]]<[-<
+<<<<<<<<<<<<<<<+>>>>>>>>>>>>>>>>>+<]<<<<<<<<<<<<<<<<[->>>>>>>>>>
+>>>>>>+<<<<<<<<<<<<<<<<]>>>>>>>>>>>>>>>>>[<<<<<<<<<+++++++++++++
++++++++++++++++++++++++++++++++++++.----------------------------
+-------------------->>>>>>>>>[-]]<<<<<<<<<[-]<[-<<<<<<<+>>>>>>>>
+>>>>>>>>>+<<<<<<<<<<]<<<<<<<[->>>>>>>+<<<<<<<]>>>>>>>>>>>>>>>>>[
+<[-]+>[-]]<[-<<<<<<<<<<<<<<<<+>>>>>>>>>>>>>>>>>+<]<<<<<<<<<<<<<<
+<<[->>>>>>>>>>>>>>>>+<<<<<<<<<<<<<<<<]>>>>>>>>>>>>>>>>>[<<<<<<<<
+<<++++++++++++++++++++++++++++++++++++++++++++++++.-------------
+----------------------------------->>>>>>>>>>[-]]<<<<<<<<<<[-]>>
+>>>>>>>[-]+[-<<<<<<<<<<<<<<<<+>>>>>>>>>>>>>>>>>+<]<<<<<<<<<<<<<<
+<<[->>>>>>>>>>>>>>>>+<<<<<<<<<<<<<<<<]>>>>>>>>>>>>>>>>>[<<<<<<<<
+<<<++++++++++++++++++++++++++++++++++++++++++++++++.------------
+------------------------------------>>>>>>>>>>>[-]]<<<<<<<<<<<[-
+]>>>>>>>>>>[-]>>>[-]>>>>>>>>>>>>>>>>>>>>>>>>>>>[-<<<<<<<<<<<<<<<
+<<<<<<<<<<<<+>>>>>>>>>>>>>>>>>>>>>>>>>>>]>>>>>>>>>>>>>>>[-]]<<<[
+-]]<<<<<<<<<<<<[-]>>>[-]>>>>>>>>>>>>>>>>>>]<<<<<<<<<<<<<<<<<<<<<
+<<<<<<<<<<<<<<<<<<<<<<<<<<<[->>>>>>>>>+<<<+<<<<<<]>>>>>>>>>[-<<<
+<<<<<<+>>>>>>>>>]<<<->>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>+<<<<<<
+<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<>+<[>-]>[-<>>>>>>>>>>>>>>>>>>>>>>>
+>>>>>>>>>>>>>-<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<>>]<<+[-]>>>>>
+>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>[<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+<<<<<<<<<<<++++++++++++++++++++++++++++++++.--------------------
+------------>[-<<<<<<<<<<<<<<<<<<<+<<<<<<+>>>>>>>>>>>>>>>>>>>>>>
+>>>]<<<<<<<<<<<<<<<<<<<[->>>>>>>>>>>>>>>>>>>+<<<<<<<<<<<<<<<<<<<
+]<<<<<++++++++++<[->-[>+>>]>[+[-<+>]>+>>]<<<<<]>>[->>>>>>>>>>+<<
+<<<<<<<<<+>]<---------->>[-<<<+>>>]<<++++++++++<[->-[>+>>]>[+[-<
++>]>+>>]<<<<<]>>[->>>>>>>>>>>+<<<<<<<<<<<<+>]<---------->>[-<<<+
+>>>]<<++++++++++<[->-[>+>>]>[+[-<+>]>+>>]<<<<<]>>[->>>>>>>>>>>>+
+<<<<<<<<<<<<<+>]<---------->>[-<<<+>>>]<<++++++++++<[->-[>+>>]>[
++[-<+>]>+>>]<<<<<]>>[->>>>>>>>>>>>>+<<<<<<<<<<<<<<+>]<----------
+>>[-<<<+>>>]<<++++++++++<[->-[>+>>]>[+[-<+>]>+>>]<<<<<]>>[->>>>>
+>>>>>>>>>+<<<<<<<<<<<<<<<+>]<---------->>[-<<<+>>>]<<++++++++++<
+[->-[>+>>]>[+[-<+>]>+>>]<<<<<]>>[->>>>>>>>>>>>>>>+<<<<<<<<<<<<<<
+<<+>]<---------->>[-<<<+>>>]<<++++++++++<[->-[>+>>]>[+[-<+>]>+>>
+]<<<<<]>>[->>>>>>>>>>>>>>>>+<<<<<<<<<<<<<<<<<+>]<---------->>[-<
+<<+>>>]<<++++++++++<[->-[>+>>]>[+[-<+>]>+>>]<<<<<]>>[->>>>>>>>>>
+>>>>>>>+<<<<<<<<<<<<<<<<<<+>]<---------->>[-<<<+>>>]<<++++++++++
+<[->-[>+>>]>[+[-<+>]>+>>]<<<<<]>>[->>>>>>>>>>>>>>>>>>+<<<<<<<<<<
+<<<<<<<<<+>]<---------->>[-<<<+>>>]<<++++++++++<[->-[>+>>]>[+[-<
++>]>+>>]<<<<<]>>[->>>>>>>>>>>>>>>>>>>+<<<<<<<<<<<<<<<<<<<<+>]<--
+-------->>[-<<<+>>>]<<<[-]>>>>>>>>>>>>>>>>>>>>>[-<<<<<<<<<<<<<<<
++>>>>>>>>>>>>>>>>>+<<]<<<<<<<<<<<<<<<[->>>>>>>>>>>>>>>+<<<<<<<<<
+<<<<<<]>>>>>>>>>>>>>>>>>[<[-]+>[-]]<[-<<<<<<<<<<<<<<<<+>>>>>>>>>
+>>>>>>>>+<]<<<<<<<<<<<<<<<<[->>>>>>>>>>>>>>>>+<<<<<<<<<<<<<<<<]>
+>>>>>>>>>>>>>>>>[<<+++++++++++++++++++++++++++++++++++++++++++++
++++.------------------------------------------------>>[-]]<<[-]<
+[-<<<<<<<<<<<<<<+>>>>>>>>>>>>>>>>>+<<<]<<<<<<<<<<<<<<[->>>>>>>>>
+>>>>>+<<<<<<<<<<<<<<]>>>>>>>>>>>>>>>>>[<[-]+>[-]]<[-<<<<<<<<<<<<
+<<<<+>>>>>>>>>>>>>>>>>+<]<<<<<<<<<<<<<<<<[->>>>>>>>>>>>>>>>+<<<<
+<<<<<<<<<<<<]>>>>>>>>>>>>>>>>>[<<<++++++++++++++++++++++++++++++
+++++++++++++++++++.---------------------------------------------
+--->>>[-]]<<<[-]<[-<<<<<<<<<<<<<+>>>>>>>>>>>>>>>>>+<<<<]<<<<<<<<
+<<<<<[->>>>>>>>>>>>>+<<<<<<<<<<<<<]>>>>>>>>>>>>>>>>>[<[-]+>[-]]<
+[-<<<<<<<<<<<<<<<<+>>>>>>>>>>>>>>>>>+<]<<<<<<<<<<<<<<<<[->>>>>>>
+>>>>>>>>>+<<<<<<<<<<<<<<<<]>>>>>>>>>>>>>>>>>[<<<<+++++++++++++++
++++++++++++++++++++++++++++++++++.------------------------------
+------------------>>>>[-]]<<<<[-]<[-<<<<<<<<<<<<+>>>>>>>>>>>>>>>
+>>+<<<<<]<<<<<<<<<<<<[->>>>>>>>>>>>+<<<<<<<<<<<<]>>>>>>>>>>>>>>>
+>>[<[-]+>[-]]<[-<<<<<<<<<<<<<<<<+>>>>>>>>>>>>>>>>>+<]<<<<<<<<<<<
+<<<<<[->>>>>>>>>>>>>>>>+<<<<<<<<<<<<<<<<]>>>>>>>>>>>>>>>>>[<<<<<
+++++++++++++++++++++++++++++++++++++++++++++++++.---------------
+--------------------------------->>>>>[-]]<<<<<[-]<[-<<<<<<<<<<<
++>>>>>>>>>>>>>>>>>+<<<<<<]<<<<<<<<<<<[->>>>>>>>>>>+<<<<<<<<<<<]>
+>>>>>>>>>>>>>>>>[<[-]+>[-]]<[-<<<<<<<<<<<<<<<<+>>>>>>>>>>>>>>>>>
++<]<<<<<<<<<<<<<<<<[->>>>>>>>>>>>>>>>+<<<<<<<<<<<<<<<<]>>>>>>>>>
+>>>>>>>>[<<<<<<++++++++++++++++++++++++++++++++++++++++++++++++.
+------------------------------------------------>>>>>>[-]]<<<<<<
+[-]<[-<<<<<<<<<<+>>>>>>>>>>>>>>>>>+<<<<<<<]<<<<<<<<<<[->>>>>>>>>
+>+<<<<<<<<<<]>>>>>>>>>>>>>>>>>[<[-]+>[-]]<[-<<<<<<<<<<<<<<<<+>>>
+>>>>>>>>>>>>>>+<]<<<<<<<<<<<<<<<<[->>>>>>>>>>>>>>>>+<<<<<<<<<<<<
+<<<<]>>>>>>>>>>>>>>>>>[<<<<<<<++++++++++++++++++++++++++++++++++
+++++++++++++++.------------------------------------------------>
+>>>>>>[-]]<<<<<<<[-]<[-<<<<<<<<<+>>>>>>>>>>>>>>>>>+<<<<<<<<]<<<<
+<<<<<[->>>>>>>>>+<<<<<<<<<]>>>>>>>>>>>>>>>>>[<[-]+>[-]]<[-<<<<<<
+<<<<<<<<<<+>>>>>>>>>>>>>>>>>+<]<<<<<<<<<<<<<<<<[->>>>>>>>>>>>>>>
+>+<<<<<<<<<<<<<<<<]>>>>>>>>>>>>>>>>>[<<<<<<<<+++++++++++++++++++
++++++++++++++++++++++++++++++.----------------------------------
+-------------->>>>>>>>[-]]<<<<<<<<[-]<[-<<<<<<<<+>>>>>>>>>>>>>>>
+>>+<<<<<<<<<]<<<<<<<<[->>>>>>>>+<<<<<<<<]>>>>>>>>>>>>>>>>>[<[-]+
+>[-]]<[-<<<<<<<<<<<<<<<<+>>>>>>>>>>>>>>>>>+<]<<<<<<<<<<<<<<<<[->
+>>>>>>>>>>>>>>>+<<<<<<<<<<<<<<<<]>>>>>>>>>>>>>>>>>[<<<<<<<<<++++
+++++++++++++++++++++++++++++++++++++++++++++.-------------------
+----------------------------->>>>>>>>>[-]]<<<<<<<<<[-]<[-<<<<<<<
++>>>>>>>>>>>>>>>>>+<<<<<<<<<<]<<<<<<<[->>>>>>>+<<<<<<<]>>>>>>>>>
+>>>>>>>>[<[-]+>[-]]<[-<<<<<<<<<<<<<<<<+>>>>>>>>>>>>>>>>>+<]<<<<<
+<<<<<<<<<<<[->>>>>>>>>>>>>>>>+<<<<<<<<<<<<<<<<]>>>>>>>>>>>>>>>>>
+[<<<<<<<<<<++++++++++++++++++++++++++++++++++++++++++++++++.----
+-------------------------------------------->>>>>>>>>>[-]]<<<<<<
+<<<<[-]>>>>>>>>>[-]+[-<<<<<<<<<<<<<<<<+>>>>>>>>>>>>>>>>>+<]<<<<<
+<<<<<<<<<<<[->>>>>>>>>>>>>>>>+<<<<<<<<<<<<<<<<]>>>>>>>>>>>>>>>>>
+[<<<<<<<<<<<++++++++++++++++++++++++++++++++++++++++++++++++.---
+--------------------------------------------->>>>>>>>>>>[-]]<<<<
+<<<<<<<[-]>>>>>>>>>>[-]>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+>>>>[-]]<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<++++++++++.--
+-------->>>>>>>>>>>>>>>>>>>>>>>>>[-]<<<<<<<<<<<<<<<<<<<<<<<<[-]>
+>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>[-]]<<<<<<<<<<<<<<<<<<]
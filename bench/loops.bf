@@ -0,0 +1,5 @@
+Long loops
+Four nested counting loops whose innermost body keeps a real loop
+so no engine can fold the nest away
+
+++++[>-[>-[>-[>+++[-]>+<<-]<-]<-]<-]>>>>>[->+<]>[<+>-]<.
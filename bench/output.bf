@@ -0,0 +1,24 @@
+Output heavy
+Prints the alphabet four times per line for about two hundred thousand lines
+
++++[>+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+++++[>++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
++++++[>>++++++++++++++++++++++++++++++++++++++++++++++++++++++++
++++++++++<++++++++++++++++++++++++++[>.+<-]>--------------------
+----------------------------------------------------------------
+-------+++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+++++++++<++++++++++++++++++++++++++[>.+<-]>---------------------
+----------------------------------------------------------------
+------++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
++++++++<++++++++++++++++++++++++++[>.+<-]>----------------------
+----------------------------------------------------------------
+-----+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+++++++<++++++++++++++++++++++++++[>.+<-]>-----------------------
+----------------------------------------------------------------
+---->++++++++++.----------<<<-]<-]<-]
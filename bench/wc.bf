@@ -0,0 +1,239 @@
+Word count
+Counts the lines words and bytes of its input like wc
+the input should not contain a zero byte
+
+>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>+[<<<<<<<<<<<<<<<<
+<<<<<,+>+<[>-]>[-<>>>>>>>>>+<<<<<<<<<>>]<<[->>>>>>+<<<+<<<]>>>>>
+>[-<<<<<<+>>>>>>]<<<->+<[>-]>[-<>>>>>>+<<<<<<>>]<<+[-]>>>>>>>>>>
+>>>>>>>>>>>+<<<<<<<<<<<<<<<[>>>>>>>>>>>>->>>-<<<<<<<<<<<<<<<[-]]
+>>>>>>>>>>>>>>>[>>>>>>>>>>>>+<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+<[->>>>>>+<<<+<<<]>>>>>>[-<<<<<<+>>>>>>]<<<---------->+<[>-]>[-<
+>>>>>>>>>+<<<<<<<<<>>]<<->+<[>-]>[-<>>>>>>>>>+>>>>>>>>>>>>>>>>>>
++<<<<<<<<<<<<<<<<<<<<<<<<<<<>>]<<---------------------->+<[>-]>[
+-<>>>>>>>>>+<<<<<<<<<>>]<<+++++++++++++++++++++++++++++++++[-]>>
+>>>>>>>>>>>>>>>>>>>>>>+<<<<<<<<<<<<<<<[>>>>>>>>>>>>>>>-<<<<<<<<<
+[-]<<<<<<[-]]>>>>>>>>>>>>>>>[<<<<<<<<<<<<+>>>[<<<->>>+[-]]<<<[>>
+>>>>>>>>>>>>>>>>+<<<<<<<<<<<<<<<<<<[-]]>>>[-]+>>>>>>>>>[-]]<<<[-
+]]<<<<<<<<<<<<<<<<<<<<<<<<[-]>>>>>>>>>>>>>>>>>>>>>]>>>>>>>>>[-<<
+<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<+<<<<<<+>>>>>>>>>
+>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>]<<<<<<<<<<<<<<<<<
+<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<[->>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+>>>>>>>>>>>>>>>>>>>+<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+<<<<<]<<<<<++++++++++<[->-[>+>>]>[+[-<+>]>+>>]<<<<<]>>[->>>>>>>>
+>>+<<<<<<<<<<<+>]<---------->>[-<<<+>>>]<<++++++++++<[->-[>+>>]>
+[+[-<+>]>+>>]<<<<<]>>[->>>>>>>>>>>+<<<<<<<<<<<<+>]<---------->>[
+-<<<+>>>]<<++++++++++<[->-[>+>>]>[+[-<+>]>+>>]<<<<<]>>[->>>>>>>>
+>>>>+<<<<<<<<<<<<<+>]<---------->>[-<<<+>>>]<<++++++++++<[->-[>+
+>>]>[+[-<+>]>+>>]<<<<<]>>[->>>>>>>>>>>>>+<<<<<<<<<<<<<<+>]<-----
+----->>[-<<<+>>>]<<++++++++++<[->-[>+>>]>[+[-<+>]>+>>]<<<<<]>>[-
+>>>>>>>>>>>>>>+<<<<<<<<<<<<<<<+>]<---------->>[-<<<+>>>]<<++++++
+++++<[->-[>+>>]>[+[-<+>]>+>>]<<<<<]>>[->>>>>>>>>>>>>>>+<<<<<<<<<
+<<<<<<<+>]<---------->>[-<<<+>>>]<<++++++++++<[->-[>+>>]>[+[-<+>
+]>+>>]<<<<<]>>[->>>>>>>>>>>>>>>>+<<<<<<<<<<<<<<<<<+>]<----------
+>>[-<<<+>>>]<<++++++++++<[->-[>+>>]>[+[-<+>]>+>>]<<<<<]>>[->>>>>
+>>>>>>>>>>>>+<<<<<<<<<<<<<<<<<<+>]<---------->>[-<<<+>>>]<<+++++
++++++<[->-[>+>>]>[+[-<+>]>+>>]<<<<<]>>[->>>>>>>>>>>>>>>>>>+<<<<<
+<<<<<<<<<<<<<<+>]<---------->>[-<<<+>>>]<<++++++++++<[->-[>+>>]>
+[+[-<+>]>+>>]<<<<<]>>[->>>>>>>>>>>>>>>>>>>+<<<<<<<<<<<<<<<<<<<<+
+>]<---------->>[-<<<+>>>]<<<[-]>>>>>>>>>>>>>>>>>>>>>[-<<<<<<<<<<
+<<<<<+>>>>>>>>>>>>>>>>>+<<]<<<<<<<<<<<<<<<[->>>>>>>>>>>>>>>+<<<<
+<<<<<<<<<<<]>>>>>>>>>>>>>>>>>[<[-]+>[-]]<[-<<<<<<<<<<<<<<<<+>>>>
+>>>>>>>>>>>>>+<]<<<<<<<<<<<<<<<<[->>>>>>>>>>>>>>>>+<<<<<<<<<<<<<
+<<<]>>>>>>>>>>>>>>>>>[<<++++++++++++++++++++++++++++++++++++++++
+++++++++.------------------------------------------------>>[-]]<
+<[-]<[-<<<<<<<<<<<<<<+>>>>>>>>>>>>>>>>>+<<<]<<<<<<<<<<<<<<[->>>>
+>>>>>>>>>>+<<<<<<<<<<<<<<]>>>>>>>>>>>>>>>>>[<[-]+>[-]]<[-<<<<<<<
+<<<<<<<<<+>>>>>>>>>>>>>>>>>+<]<<<<<<<<<<<<<<<<[->>>>>>>>>>>>>>>>
++<<<<<<<<<<<<<<<<]>>>>>>>>>>>>>>>>>[<<<+++++++++++++++++++++++++
++++++++++++++++++++++++.----------------------------------------
+-------->>>[-]]<<<[-]<[-<<<<<<<<<<<<<+>>>>>>>>>>>>>>>>>+<<<<]<<<
+<<<<<<<<<<[->>>>>>>>>>>>>+<<<<<<<<<<<<<]>>>>>>>>>>>>>>>>>[<[-]+>
+[-]]<[-<<<<<<<<<<<<<<<<+>>>>>>>>>>>>>>>>>+<]<<<<<<<<<<<<<<<<[->>
+>>>>>>>>>>>>>>+<<<<<<<<<<<<<<<<]>>>>>>>>>>>>>>>>>[<<<<++++++++++
+++++++++++++++++++++++++++++++++++++++.-------------------------
+----------------------->>>>[-]]<<<<[-]<[-<<<<<<<<<<<<+>>>>>>>>>>
+>>>>>>>+<<<<<]<<<<<<<<<<<<[->>>>>>>>>>>>+<<<<<<<<<<<<]>>>>>>>>>>
+>>>>>>>[<[-]+>[-]]<[-<<<<<<<<<<<<<<<<+>>>>>>>>>>>>>>>>>+<]<<<<<<
+<<<<<<<<<<[->>>>>>>>>>>>>>>>+<<<<<<<<<<<<<<<<]>>>>>>>>>>>>>>>>>[
+<<<<<++++++++++++++++++++++++++++++++++++++++++++++++.----------
+-------------------------------------->>>>>[-]]<<<<<[-]<[-<<<<<<
+<<<<<+>>>>>>>>>>>>>>>>>+<<<<<<]<<<<<<<<<<<[->>>>>>>>>>>+<<<<<<<<
+<<<]>>>>>>>>>>>>>>>>>[<[-]+>[-]]<[-<<<<<<<<<<<<<<<<+>>>>>>>>>>>>
+>>>>>+<]<<<<<<<<<<<<<<<<[->>>>>>>>>>>>>>>>+<<<<<<<<<<<<<<<<]>>>>
+>>>>>>>>>>>>>[<<<<<<++++++++++++++++++++++++++++++++++++++++++++
+++++.------------------------------------------------>>>>>>[-]]<
+<<<<<[-]<[-<<<<<<<<<<+>>>>>>>>>>>>>>>>>+<<<<<<<]<<<<<<<<<<[->>>>
+>>>>>>+<<<<<<<<<<]>>>>>>>>>>>>>>>>>[<[-]+>[-]]<[-<<<<<<<<<<<<<<<
+<+>>>>>>>>>>>>>>>>>+<]<<<<<<<<<<<<<<<<[->>>>>>>>>>>>>>>>+<<<<<<<
+<<<<<<<<<]>>>>>>>>>>>>>>>>>[<<<<<<<+++++++++++++++++++++++++++++
++++++++++++++++++++.--------------------------------------------
+---->>>>>>>[-]]<<<<<<<[-]<[-<<<<<<<<<+>>>>>>>>>>>>>>>>>+<<<<<<<<
+]<<<<<<<<<[->>>>>>>>>+<<<<<<<<<]>>>>>>>>>>>>>>>>>[<[-]+>[-]]<[-<
+<<<<<<<<<<<<<<<+>>>>>>>>>>>>>>>>>+<]<<<<<<<<<<<<<<<<[->>>>>>>>>>
+>>>>>>+<<<<<<<<<<<<<<<<]>>>>>>>>>>>>>>>>>[<<<<<<<<++++++++++++++
+++++++++++++++++++++++++++++++++++.-----------------------------
+------------------->>>>>>>>[-]]<<<<<<<<[-]<[-<<<<<<<<+>>>>>>>>>>
+>>>>>>>+<<<<<<<<<]<<<<<<<<[->>>>>>>>+<<<<<<<<]>>>>>>>>>>>>>>>>>[
+<[-]+>[-]]<[-<<<<<<<<<<<<<<<<+>>>>>>>>>>>>>>>>>+<]<<<<<<<<<<<<<<
+<<[->>>>>>>>>>>>>>>>+<<<<<<<<<<<<<<<<]>>>>>>>>>>>>>>>>>[<<<<<<<<
+<++++++++++++++++++++++++++++++++++++++++++++++++.--------------
+---------------------------------->>>>>>>>>[-]]<<<<<<<<<[-]<[-<<
+<<<<<+>>>>>>>>>>>>>>>>>+<<<<<<<<<<]<<<<<<<[->>>>>>>+<<<<<<<]>>>>
+>>>>>>>>>>>>>[<[-]+>[-]]<[-<<<<<<<<<<<<<<<<+>>>>>>>>>>>>>>>>>+<]
+<<<<<<<<<<<<<<<<[->>>>>>>>>>>>>>>>+<<<<<<<<<<<<<<<<]>>>>>>>>>>>>
+>>>>>[<<<<<<<<<<++++++++++++++++++++++++++++++++++++++++++++++++
+.------------------------------------------------>>>>>>>>>>[-]]<
+<<<<<<<<<[-]>>>>>>>>>[-]+[-<<<<<<<<<<<<<<<<+>>>>>>>>>>>>>>>>>+<]
+<<<<<<<<<<<<<<<<[->>>>>>>>>>>>>>>>+<<<<<<<<<<<<<<<<]>>>>>>>>>>>>
+>>>>>[<<<<<<<<<<<+++++++++++++++++++++++++++++++++++++++++++++++
++.------------------------------------------------>>>>>>>>>>>[-]
+]<<<<<<<<<<<[-]>>>>>>>>>>[-]>>++++++++++++++++++++++++++++++++.-
+------------------------------->>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+>[-<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<+<<<<<<+>
+>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>]<<<<<<
+<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<[->>>>>>>>>>>>>>>>
+>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>+<<<<<<<<<<<<<<<<<<<<<<<<<<<
+<<<<<<<<<<<<<<<<<<<<<<<<<]<<<<<++++++++++<[->-[>+>>]>[+[-<+>]>+>
+>]<<<<<]>>[->>>>>>>>>>+<<<<<<<<<<<+>]<---------->>[-<<<+>>>]<<++
+++++++++<[->-[>+>>]>[+[-<+>]>+>>]<<<<<]>>[->>>>>>>>>>>+<<<<<<<<<
+<<<+>]<---------->>[-<<<+>>>]<<++++++++++<[->-[>+>>]>[+[-<+>]>+>
+>]<<<<<]>>[->>>>>>>>>>>>+<<<<<<<<<<<<<+>]<---------->>[-<<<+>>>]
+<<++++++++++<[->-[>+>>]>[+[-<+>]>+>>]<<<<<]>>[->>>>>>>>>>>>>+<<<
+<<<<<<<<<<<+>]<---------->>[-<<<+>>>]<<++++++++++<[->-[>+>>]>[+[
+-<+>]>+>>]<<<<<]>>[->>>>>>>>>>>>>>+<<<<<<<<<<<<<<<+>]<----------
+>>[-<<<+>>>]<<++++++++++<[->-[>+>>]>[+[-<+>]>+>>]<<<<<]>>[->>>>>
+>>>>>>>>>>+<<<<<<<<<<<<<<<<+>]<---------->>[-<<<+>>>]<<+++++++++
++<[->-[>+>>]>[+[-<+>]>+>>]<<<<<]>>[->>>>>>>>>>>>>>>>+<<<<<<<<<<<
+<<<<<<+>]<---------->>[-<<<+>>>]<<++++++++++<[->-[>+>>]>[+[-<+>]
+>+>>]<<<<<]>>[->>>>>>>>>>>>>>>>>+<<<<<<<<<<<<<<<<<<+>]<---------
+->>[-<<<+>>>]<<++++++++++<[->-[>+>>]>[+[-<+>]>+>>]<<<<<]>>[->>>>
+>>>>>>>>>>>>>>+<<<<<<<<<<<<<<<<<<<+>]<---------->>[-<<<+>>>]<<++
+++++++++<[->-[>+>>]>[+[-<+>]>+>>]<<<<<]>>[->>>>>>>>>>>>>>>>>>>+<
+<<<<<<<<<<<<<<<<<<<+>]<---------->>[-<<<+>>>]<<<[-]>>>>>>>>>>>>>
+>>>>>>>>[-<<<<<<<<<<<<<<<+>>>>>>>>>>>>>>>>>+<<]<<<<<<<<<<<<<<<[-
+>>>>>>>>>>>>>>>+<<<<<<<<<<<<<<<]>>>>>>>>>>>>>>>>>[<[-]+>[-]]<[-<
+<<<<<<<<<<<<<<<+>>>>>>>>>>>>>>>>>+<]<<<<<<<<<<<<<<<<[->>>>>>>>>>
+>>>>>>+<<<<<<<<<<<<<<<<]>>>>>>>>>>>>>>>>>[<<++++++++++++++++++++
+++++++++++++++++++++++++++++.-----------------------------------
+------------->>[-]]<<[-]<[-<<<<<<<<<<<<<<+>>>>>>>>>>>>>>>>>+<<<]
+<<<<<<<<<<<<<<[->>>>>>>>>>>>>>+<<<<<<<<<<<<<<]>>>>>>>>>>>>>>>>>[
+<[-]+>[-]]<[-<<<<<<<<<<<<<<<<+>>>>>>>>>>>>>>>>>+<]<<<<<<<<<<<<<<
+<<[->>>>>>>>>>>>>>>>+<<<<<<<<<<<<<<<<]>>>>>>>>>>>>>>>>>[<<<+++++
++++++++++++++++++++++++++++++++++++++++++++.--------------------
+---------------------------->>>[-]]<<<[-]<[-<<<<<<<<<<<<<+>>>>>>
+>>>>>>>>>>>+<<<<]<<<<<<<<<<<<<[->>>>>>>>>>>>>+<<<<<<<<<<<<<]>>>>
+>>>>>>>>>>>>>[<[-]+>[-]]<[-<<<<<<<<<<<<<<<<+>>>>>>>>>>>>>>>>>+<]
+<<<<<<<<<<<<<<<<[->>>>>>>>>>>>>>>>+<<<<<<<<<<<<<<<<]>>>>>>>>>>>>
+>>>>>[<<<<++++++++++++++++++++++++++++++++++++++++++++++++.-----
+------------------------------------------->>>>[-]]<<<<[-]<[-<<<
+<<<<<<<<<+>>>>>>>>>>>>>>>>>+<<<<<]<<<<<<<<<<<<[->>>>>>>>>>>>+<<<
+<<<<<<<<<]>>>>>>>>>>>>>>>>>[<[-]+>[-]]<[-<<<<<<<<<<<<<<<<+>>>>>>
+>>>>>>>>>>>+<]<<<<<<<<<<<<<<<<[->>>>>>>>>>>>>>>>+<<<<<<<<<<<<<<<
+<]>>>>>>>>>>>>>>>>>[<<<<<+++++++++++++++++++++++++++++++++++++++
++++++++++.------------------------------------------------>>>>>[
+-]]<<<<<[-]<[-<<<<<<<<<<<+>>>>>>>>>>>>>>>>>+<<<<<<]<<<<<<<<<<<[-
+>>>>>>>>>>>+<<<<<<<<<<<]>>>>>>>>>>>>>>>>>[<[-]+>[-]]<[-<<<<<<<<<
+<<<<<<<+>>>>>>>>>>>>>>>>>+<]<<<<<<<<<<<<<<<<[->>>>>>>>>>>>>>>>+<
+<<<<<<<<<<<<<<<]>>>>>>>>>>>>>>>>>[<<<<<<++++++++++++++++++++++++
+++++++++++++++++++++++++.---------------------------------------
+--------->>>>>>[-]]<<<<<<[-]<[-<<<<<<<<<<+>>>>>>>>>>>>>>>>>+<<<<
+<<<]<<<<<<<<<<[->>>>>>>>>>+<<<<<<<<<<]>>>>>>>>>>>>>>>>>[<[-]+>[-
+]]<[-<<<<<<<<<<<<<<<<+>>>>>>>>>>>>>>>>>+<]<<<<<<<<<<<<<<<<[->>>>
+>>>>>>>>>>>>+<<<<<<<<<<<<<<<<]>>>>>>>>>>>>>>>>>[<<<<<<<+++++++++
++++++++++++++++++++++++++++++++++++++++.------------------------
+------------------------>>>>>>>[-]]<<<<<<<[-]<[-<<<<<<<<<+>>>>>>
+>>>>>>>>>>>+<<<<<<<<]<<<<<<<<<[->>>>>>>>>+<<<<<<<<<]>>>>>>>>>>>>
+>>>>>[<[-]+>[-]]<[-<<<<<<<<<<<<<<<<+>>>>>>>>>>>>>>>>>+<]<<<<<<<<
+<<<<<<<<[->>>>>>>>>>>>>>>>+<<<<<<<<<<<<<<<<]>>>>>>>>>>>>>>>>>[<<
+<<<<<<++++++++++++++++++++++++++++++++++++++++++++++++.---------
+--------------------------------------->>>>>>>>[-]]<<<<<<<<[-]<[
+-<<<<<<<<+>>>>>>>>>>>>>>>>>+<<<<<<<<<]<<<<<<<<[->>>>>>>>+<<<<<<<
+<]>>>>>>>>>>>>>>>>>[<[-]+>[-]]<[-<<<<<<<<<<<<<<<<+>>>>>>>>>>>>>>
+>>>+<]<<<<<<<<<<<<<<<<[->>>>>>>>>>>>>>>>+<<<<<<<<<<<<<<<<]>>>>>>
+>>>>>>>>>>>[<<<<<<<<<+++++++++++++++++++++++++++++++++++++++++++
++++++.------------------------------------------------>>>>>>>>>[
+-]]<<<<<<<<<[-]<[-<<<<<<<+>>>>>>>>>>>>>>>>>+<<<<<<<<<<]<<<<<<<[-
+>>>>>>>+<<<<<<<]>>>>>>>>>>>>>>>>>[<[-]+>[-]]<[-<<<<<<<<<<<<<<<<+
+>>>>>>>>>>>>>>>>>+<]<<<<<<<<<<<<<<<<[->>>>>>>>>>>>>>>>+<<<<<<<<<
+<<<<<<<]>>>>>>>>>>>>>>>>>[<<<<<<<<<<++++++++++++++++++++++++++++
+++++++++++++++++++++.-------------------------------------------
+----->>>>>>>>>>[-]]<<<<<<<<<<[-]>>>>>>>>>[-]+[-<<<<<<<<<<<<<<<<+
+>>>>>>>>>>>>>>>>>+<]<<<<<<<<<<<<<<<<[->>>>>>>>>>>>>>>>+<<<<<<<<<
+<<<<<<<]>>>>>>>>>>>>>>>>>[<<<<<<<<<<<+++++++++++++++++++++++++++
++++++++++++++++++++++.------------------------------------------
+------>>>>>>>>>>>[-]]<<<<<<<<<<<[-]>>>>>>>>>>[-]>>++++++++++++++
+++++++++++++++++++.-------------------------------->>>>>>>>>>>>>
+>>>>>>>>>>>>>>>>>>>>>>>>[-<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+<<<<<<<<<<<<<<<<<+<<<<<<+>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+>>>>>>>>>>>>>>>>>>>>>>]<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+<<<<<<<<<<<<<<[->>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+>>>>>>>+<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<]
+<<<<<++++++++++<[->-[>+>>]>[+[-<+>]>+>>]<<<<<]>>[->>>>>>>>>>+<<<
+<<<<<<<<+>]<---------->>[-<<<+>>>]<<++++++++++<[->-[>+>>]>[+[-<+
+>]>+>>]<<<<<]>>[->>>>>>>>>>>+<<<<<<<<<<<<+>]<---------->>[-<<<+>
+>>]<<++++++++++<[->-[>+>>]>[+[-<+>]>+>>]<<<<<]>>[->>>>>>>>>>>>+<
+<<<<<<<<<<<<+>]<---------->>[-<<<+>>>]<<++++++++++<[->-[>+>>]>[+
+[-<+>]>+>>]<<<<<]>>[->>>>>>>>>>>>>+<<<<<<<<<<<<<<+>]<---------->
+>[-<<<+>>>]<<++++++++++<[->-[>+>>]>[+[-<+>]>+>>]<<<<<]>>[->>>>>>
+>>>>>>>>+<<<<<<<<<<<<<<<+>]<---------->>[-<<<+>>>]<<++++++++++<[
+->-[>+>>]>[+[-<+>]>+>>]<<<<<]>>[->>>>>>>>>>>>>>>+<<<<<<<<<<<<<<<
+<+>]<---------->>[-<<<+>>>]<<++++++++++<[->-[>+>>]>[+[-<+>]>+>>]
+<<<<<]>>[->>>>>>>>>>>>>>>>+<<<<<<<<<<<<<<<<<+>]<---------->>[-<<
+<+>>>]<<++++++++++<[->-[>+>>]>[+[-<+>]>+>>]<<<<<]>>[->>>>>>>>>>>
+>>>>>>+<<<<<<<<<<<<<<<<<<+>]<---------->>[-<<<+>>>]<<++++++++++<
+[->-[>+>>]>[+[-<+>]>+>>]<<<<<]>>[->>>>>>>>>>>>>>>>>>+<<<<<<<<<<<
+<<<<<<<<+>]<---------->>[-<<<+>>>]<<++++++++++<[->-[>+>>]>[+[-<+
+>]>+>>]<<<<<]>>[->>>>>>>>>>>>>>>>>>>+<<<<<<<<<<<<<<<<<<<<+>]<---
+------->>[-<<<+>>>]<<<[-]>>>>>>>>>>>>>>>>>>>>>[-<<<<<<<<<<<<<<<+
+>>>>>>>>>>>>>>>>>+<<]<<<<<<<<<<<<<<<[->>>>>>>>>>>>>>>+<<<<<<<<<<
+<<<<<]>>>>>>>>>>>>>>>>>[<[-]+>[-]]<[-<<<<<<<<<<<<<<<<+>>>>>>>>>>
+>>>>>>>+<]<<<<<<<<<<<<<<<<[->>>>>>>>>>>>>>>>+<<<<<<<<<<<<<<<<]>>
+>>>>>>>>>>>>>>>[<<++++++++++++++++++++++++++++++++++++++++++++++
+++.------------------------------------------------>>[-]]<<[-]<[
+-<<<<<<<<<<<<<<+>>>>>>>>>>>>>>>>>+<<<]<<<<<<<<<<<<<<[->>>>>>>>>>
+>>>>+<<<<<<<<<<<<<<]>>>>>>>>>>>>>>>>>[<[-]+>[-]]<[-<<<<<<<<<<<<<
+<<<+>>>>>>>>>>>>>>>>>+<]<<<<<<<<<<<<<<<<[->>>>>>>>>>>>>>>>+<<<<<
+<<<<<<<<<<<]>>>>>>>>>>>>>>>>>[<<<+++++++++++++++++++++++++++++++
++++++++++++++++++.----------------------------------------------
+-->>>[-]]<<<[-]<[-<<<<<<<<<<<<<+>>>>>>>>>>>>>>>>>+<<<<]<<<<<<<<<
+<<<<[->>>>>>>>>>>>>+<<<<<<<<<<<<<]>>>>>>>>>>>>>>>>>[<[-]+>[-]]<[
+-<<<<<<<<<<<<<<<<+>>>>>>>>>>>>>>>>>+<]<<<<<<<<<<<<<<<<[->>>>>>>>
+>>>>>>>>+<<<<<<<<<<<<<<<<]>>>>>>>>>>>>>>>>>[<<<<++++++++++++++++
+++++++++++++++++++++++++++++++++.-------------------------------
+----------------->>>>[-]]<<<<[-]<[-<<<<<<<<<<<<+>>>>>>>>>>>>>>>>
+>+<<<<<]<<<<<<<<<<<<[->>>>>>>>>>>>+<<<<<<<<<<<<]>>>>>>>>>>>>>>>>
+>[<[-]+>[-]]<[-<<<<<<<<<<<<<<<<+>>>>>>>>>>>>>>>>>+<]<<<<<<<<<<<<
+<<<<[->>>>>>>>>>>>>>>>+<<<<<<<<<<<<<<<<]>>>>>>>>>>>>>>>>>[<<<<<+
++++++++++++++++++++++++++++++++++++++++++++++++.----------------
+-------------------------------->>>>>[-]]<<<<<[-]<[-<<<<<<<<<<<+
+>>>>>>>>>>>>>>>>>+<<<<<<]<<<<<<<<<<<[->>>>>>>>>>>+<<<<<<<<<<<]>>
+>>>>>>>>>>>>>>>[<[-]+>[-]]<[-<<<<<<<<<<<<<<<<+>>>>>>>>>>>>>>>>>+
+<]<<<<<<<<<<<<<<<<[->>>>>>>>>>>>>>>>+<<<<<<<<<<<<<<<<]>>>>>>>>>>
+>>>>>>>[<<<<<<++++++++++++++++++++++++++++++++++++++++++++++++.-
+----------------------------------------------->>>>>>[-]]<<<<<<[
+-]<[-<<<<<<<<<<+>>>>>>>>>>>>>>>>>+<<<<<<<]<<<<<<<<<<[->>>>>>>>>>
++<<<<<<<<<<]>>>>>>>>>>>>>>>>>[<[-]+>[-]]<[-<<<<<<<<<<<<<<<<+>>>>
+>>>>>>>>>>>>>+<]<<<<<<<<<<<<<<<<[->>>>>>>>>>>>>>>>+<<<<<<<<<<<<<
+<<<]>>>>>>>>>>>>>>>>>[<<<<<<<+++++++++++++++++++++++++++++++++++
++++++++++++++.------------------------------------------------>>
+>>>>>[-]]<<<<<<<[-]<[-<<<<<<<<<+>>>>>>>>>>>>>>>>>+<<<<<<<<]<<<<<
+<<<<[->>>>>>>>>+<<<<<<<<<]>>>>>>>>>>>>>>>>>[<[-]+>[-]]<[-<<<<<<<
+<<<<<<<<<+>>>>>>>>>>>>>>>>>+<]<<<<<<<<<<<<<<<<[->>>>>>>>>>>>>>>>
++<<<<<<<<<<<<<<<<]>>>>>>>>>>>>>>>>>[<<<<<<<<++++++++++++++++++++
+++++++++++++++++++++++++++++.-----------------------------------
+------------->>>>>>>>[-]]<<<<<<<<[-]<[-<<<<<<<<+>>>>>>>>>>>>>>>>
+>+<<<<<<<<<]<<<<<<<<[->>>>>>>>+<<<<<<<<]>>>>>>>>>>>>>>>>>[<[-]+>
+[-]]<[-<<<<<<<<<<<<<<<<+>>>>>>>>>>>>>>>>>+<]<<<<<<<<<<<<<<<<[->>
+>>>>>>>>>>>>>>+<<<<<<<<<<<<<<<<]>>>>>>>>>>>>>>>>>[<<<<<<<<<+++++
++++++++++++++++++++++++++++++++++++++++++++.--------------------
+---------------------------->>>>>>>>>[-]]<<<<<<<<<[-]<[-<<<<<<<+
+>>>>>>>>>>>>>>>>>+<<<<<<<<<<]<<<<<<<[->>>>>>>+<<<<<<<]>>>>>>>>>>
+>>>>>>>[<[-]+>[-]]<[-<<<<<<<<<<<<<<<<+>>>>>>>>>>>>>>>>>+<]<<<<<<
+<<<<<<<<<<[->>>>>>>>>>>>>>>>+<<<<<<<<<<<<<<<<]>>>>>>>>>>>>>>>>>[
+<<<<<<<<<<++++++++++++++++++++++++++++++++++++++++++++++++.-----
+------------------------------------------->>>>>>>>>>[-]]<<<<<<<
+<<<[-]>>>>>>>>>[-]+[-<<<<<<<<<<<<<<<<+>>>>>>>>>>>>>>>>>+<]<<<<<<
+<<<<<<<<<<[->>>>>>>>>>>>>>>>+<<<<<<<<<<<<<<<<]>>>>>>>>>>>>>>>>>[
+<<<<<<<<<<<++++++++++++++++++++++++++++++++++++++++++++++++.----
+-------------------------------------------->>>>>>>>>>>[-]]<<<<<
+<<<<<<[-]>>>>>>>>>>[-]>>++++++++++.----------
@@ -0,0 +1,70 @@
+//libbrainfck, the parser, optimizer and interpreter of brainfck without the command line around them
+//a program is compiled once and can then be run any number of times, also from several threads at once
+//nothing is read from or written to the standard streams and no error ends the process
+//build it with make lib, which gives bin/libbrainfck.a and bin/libbrainfck.so
+
+#ifndef BRAINFCK_H
+#define BRAINFCK_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#if defined(__GNUC__)
+    #define BRAINFCK_API __attribute__((visibility("default")))
+#else
+    #define BRAINFCK_API
+#endif
+
+typedef enum {
+    BRAINFCK_OK = 0,
+    BRAINFCK_ERROR_ARGUMENT, // an option or argument is invalid
+    BRAINFCK_ERROR_SYNTAX, // unmatched brackets
+    BRAINFCK_ERROR_MEMORY, // out of memory, a failed call may leak what it allocated
+    BRAINFCK_ERROR_TAPE_UNDERFLOW, // the data pointer moved in front of the first cell
+    BRAINFCK_ERROR_TAPE_LIMIT, // a cell past max_tape_bytes, rounded up to 64KB, was touched
+    BRAINFCK_ERROR_ITERATION_LIMIT, // the run took more than max_iterations loop iterations
+    BRAINFCK_ERROR_OUTPUT_LIMIT, // the run wrote more than max_output bytes or more than fit in the output buffer
+    BRAINFCK_ERROR_OUTPUT, // the write callback did not take all the bytes it was given
+} BrainfckStatus;
+
+
+//zero for every field gives the defaults
+typedef struct {
+    uint32_t cell_bits; // 8, 16 or 32 (Default 8)
+    uint64_t max_tape_bytes; // size of the tape in bytes, rounded up to 64KB (Default 4GB, or what the program provably needs)
+    uint64_t max_iterations; // loop iterations one run may take (Default no limit)
+    uint64_t max_output; // bytes one run may write (Default no limit)
+} BrainfckOptions;
+
+
+//where a run reads its input from and writes its output to
+//input is read in place, read is used instead when it is set
+//output is written straight into output when it is set, otherwise it is handed to write in blocks
+//without either the output is dropped
+typedef struct {
+    const uint8_t* input;
+    size_t input_size;
+    int (*read)(void* context); // returns the next byte or a negative value at the end of the input
+    uint8_t* output;
+    size_t output_capacity;
+    size_t (*write)(void* context, const uint8_t* data, size_t size); // returns how many bytes it took
+    void* context; // passed to read and write
+    size_t output_size; // set by brainfck_run to the bytes written, also when it fails
+} BrainfckIo;
+
+
+typedef struct BrainfckProgram BrainfckProgram;
+
+
+//parses and optimizes size bytes of source, options may be NULL
+BRAINFCK_API BrainfckStatus brainfck_compile(const char* source, size_t size, const BrainfckOptions* options, BrainfckProgram** program);
+
+//runs the program from the start on a fresh tape
+BRAINFCK_API BrainfckStatus brainfck_run(const BrainfckProgram* program, BrainfckIo* io);
+
+BRAINFCK_API void brainfck_free(BrainfckProgram* program);
+
+//describes why the last failed call on this thread failed
+BRAINFCK_API const char* brainfck_error_message(void);
+
+#endif
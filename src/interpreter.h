@@ -0,0 +1,256 @@
+//the interpreter loop, main.c includes this once per cell width
+//CELL is the unsigned cell type and INTERPRET_PROGAM the name of the generated function
+//so every width gets its own handlers without checking the width per instruction
+//with PROFILE defined it is included once more per width as the --profile interpreter
+//which counts every executed instruction and tracks the highest cell touched, the normal one compiles all of that out
+//the normal one can also continue from a Prerun instead of the start of the progam
+//with LIMITED defined it is the library interpreter, which stops after max_iterations loop iterations
+//with TIERED defined it is the --tiered interpreter, which counts the back jumps of every loop
+//and once one gets hot has tier_compile turn it into a NativeLoop, that runs on the same tape from then on
+//the caller owns the tape, the io and the bytecode, so a batch worker can reuse its tape for every run
+//and a library run that is stopped by a fault or limit can still free all of them
+//the bytecode is only read, runs on several threads can share it
+
+#if defined(PROFILE)
+    #define COUNT_INSTRUCTION() counts[pc - code->data]++
+    #define TOUCH(pointer) if((pointer) > high_water) high_water = (pointer)
+INTERNAL void INTERPRET_PROGAM(Bytecode* code, Tape* tape, Io* io, Profile* profile){
+#elif defined(LIMITED)
+    #define COUNT_INSTRUCTION()
+    #define TOUCH(pointer)
+INTERNAL void INTERPRET_PROGAM(Bytecode* code, Tape* tape, Io* io, uint64_t max_iterations){
+    uint64_t iterations_left = max_iterations;
+#elif defined(TIERED)
+    #define COUNT_INSTRUCTION()
+    #define TOUCH(pointer)
+    #define RUN_NATIVE(loop) dp = (CELL*)(tape_start + tier->loops[loop].run(tape_start, (uint8_t*)dp - tape_start))
+INTERNAL void INTERPRET_PROGAM(Bytecode* code, Tape* tape, Io* io, Tier* tier){
+#else
+    #define COUNT_INSTRUCTION()
+    #define TOUCH(pointer)
+INTERNAL void INTERPRET_PROGAM(Bytecode* code, Tape* tape, Io* io, Prerun* prerun){
+#endif
+    const uint8_t* pc = code->data;
+    CELL* dp = (CELL*)tape->cells;
+    //kept in locals, stores to char cells could alias the tape otherwise
+    uint8_t* tape_start = (uint8_t*)tape->cells;
+    uint8_t* tape_end = tape_start + tape->size;
+
+#if !defined(PROFILE) && !defined(LIMITED) && !defined(TIERED)
+    //continues where the progam was run ahead to
+    if(prerun != NULL){
+        for(uint32_t i = 0; i < prerun->output_size; i++) io_write(io, prerun->output[i]);
+        memcpy(tape->cells, prerun->tape, prerun->tape_cells * sizeof(CELL));
+        dp += prerun->dp;
+        pc += code->offsets[prerun->ip];
+    }
+#endif
+
+#if defined(PROFILE)
+    uint64_t* counts = profile->counts;
+    CELL* high_water = dp;
+#endif
+
+#if defined(THREADED_DISPATCH)
+    static void* const handlers[OP_END + 1] = {
+        [OP_MOVE] = &&op_move,
+        [OP_MOVE_WIDE] = &&op_move_wide,
+        [OP_ADD] = &&op_add,
+        [OP_ADD_WIDE] = &&op_add_wide,
+        [OP_PRINT] = &&op_print,
+        [OP_PRINT_WIDE] = &&op_print_wide,
+        [OP_INPUT] = &&op_input,
+        [OP_INPUT_WIDE] = &&op_input_wide,
+        [OP_JMP_ZERO] = &&op_jmp_zero,
+        [OP_JMP_ZERO_WIDE] = &&op_jmp_zero_wide,
+        [OP_JMP_NON_ZERO] = &&op_jmp_non_zero,
+        [OP_JMP_NON_ZERO_WIDE] = &&op_jmp_non_zero_wide,
+        [OP_SET_ZERO] = &&op_set_zero,
+        [OP_SET_ZERO_WIDE] = &&op_set_zero_wide,
+        [OP_MUL_ADD] = &&op_mul_add,
+        [OP_MUL_ADD_WIDE] = &&op_mul_add_wide,
+        [OP_SCAN_RIGHT] = &&op_scan_right,
+        [OP_SCAN_LEFT] = &&op_scan_left,
+#if defined(TIERED)
+        [OP_NATIVE] = &&op_native,
+        [OP_NATIVE_WIDE] = &&op_native_wide,
+#endif
+        [OP_END] = &&op_end,
+    };
+
+    goto *handlers[*pc];
+#else
+    while(true){
+        switch (*pc) {
+#endif
+            INSTRUCTION(op_move, OP_MOVE){
+                dp += (int8_t)pc[1];
+                TOUCH(dp);
+                NEXT(2);
+            }
+            INSTRUCTION(op_move_wide, OP_MOVE_WIDE){
+                dp += bytecode_i32(pc + 1);
+                TOUCH(dp);
+                NEXT(5);
+            }
+            INSTRUCTION(op_add, OP_ADD){
+                dp[(int8_t)pc[1]] += (int8_t)pc[2];
+                TOUCH(dp + (int8_t)pc[1]);
+                NEXT(3);
+            }
+            INSTRUCTION(op_add_wide, OP_ADD_WIDE){
+                int32_t cell = bytecode_i32(pc + 1);
+                dp[cell] += (CELL)bytecode_i32(pc + 5);
+                TOUCH(dp + cell);
+                NEXT(9);
+            }
+            INSTRUCTION(op_print, OP_PRINT){
+                io_write(io, dp[(int8_t)pc[1]]);
+                TOUCH(dp + (int8_t)pc[1]);
+                NEXT(2);
+            }
+            INSTRUCTION(op_print_wide, OP_PRINT_WIDE){
+                int32_t cell = bytecode_i32(pc + 1);
+                uint32_t count = bytecode_i32(pc + 5);
+                for(uint32_t i = 0; i < count; i++){
+                    io_write(io, dp[cell]);
+                }
+                TOUCH(dp + cell);
+                NEXT(9);
+            }
+            INSTRUCTION(op_input, OP_INPUT){
+                dp[(int8_t)pc[1]] = io_read(io);
+                TOUCH(dp + (int8_t)pc[1]);
+                NEXT(2);
+            }
+            INSTRUCTION(op_input_wide, OP_INPUT_WIDE){
+                int32_t cell = bytecode_i32(pc + 1);
+                dp[cell] = io_read(io);
+                TOUCH(dp + cell);
+                NEXT(5);
+            }
+            INSTRUCTION(op_jmp_zero, OP_JMP_ZERO){
+                NEXT(*dp == 0 ? 2 + (int8_t)pc[1] : 2);
+            }
+            INSTRUCTION(op_jmp_zero_wide, OP_JMP_ZERO_WIDE){
+                NEXT(*dp == 0 ? 5 + bytecode_i32(pc + 1) : 5);
+            }
+            INSTRUCTION(op_jmp_non_zero, OP_JMP_NON_ZERO){
+                if(*dp != 0){
+#if defined(LIMITED)
+                    if(iterations_left-- == 0) fatal_status(BRAINFCK_ERROR_ITERATION_LIMIT, "Iteration limit of %" PRIu64 " exceeded\n", max_iterations);
+#elif defined(TIERED)
+                    //the native loop starts at the '[', which takes the same branch as this jump
+                    if(++tier->heat[pc - code->data] == TIER_THRESHOLD){
+                        //compiling can move tier->loops, so it has to be done before RUN_NATIVE reads it
+                        uint32_t loop = tier_compile(tier, pc - code->data);
+                        RUN_NATIVE(loop);
+                        NEXT(2);
+                    }
+#endif
+                    NEXT(2 + (int8_t)pc[1]);
+                }
+                NEXT(2);
+            }
+            INSTRUCTION(op_jmp_non_zero_wide, OP_JMP_NON_ZERO_WIDE){
+                if(*dp != 0){
+#if defined(LIMITED)
+                    if(iterations_left-- == 0) fatal_status(BRAINFCK_ERROR_ITERATION_LIMIT, "Iteration limit of %" PRIu64 " exceeded\n", max_iterations);
+#elif defined(TIERED)
+                    if(++tier->heat[pc - code->data] == TIER_THRESHOLD){
+                        //compiling can move tier->loops, so it has to be done before RUN_NATIVE reads it
+                        uint32_t loop = tier_compile(tier, pc - code->data);
+                        RUN_NATIVE(loop);
+                        NEXT(5);
+                    }
+#endif
+                    NEXT(5 + bytecode_i32(pc + 1));
+                }
+                NEXT(5);
+            }
+            INSTRUCTION(op_set_zero, OP_SET_ZERO){
+                dp[(int8_t)pc[1]] = 0;
+                TOUCH(dp + (int8_t)pc[1]);
+                NEXT(2);
+            }
+            INSTRUCTION(op_set_zero_wide, OP_SET_ZERO_WIDE){
+                int32_t cell = bytecode_i32(pc + 1);
+                dp[cell] = 0;
+                TOUCH(dp + cell);
+                NEXT(5);
+            }
+            INSTRUCTION(op_mul_add, OP_MUL_ADD){
+                CELL value = dp[(int8_t)pc[1]];
+                uint32_t count = pc[2];
+                if(value != 0){
+                    for(uint32_t i = 0; i < count; i++){
+                        const uint8_t* pair = pc + 3 + 2 * i;
+                        dp[(int8_t)pair[0]] += value * (int8_t)pair[1];
+                        TOUCH(dp + (int8_t)pair[0]);
+                    }
+                }
+                TOUCH(dp + (int8_t)pc[1]);
+                NEXT(3 + 2 * count);
+            }
+            INSTRUCTION(op_mul_add_wide, OP_MUL_ADD_WIDE){
+                int32_t cell = bytecode_i32(pc + 1);
+                CELL value = dp[cell];
+                uint32_t count = pc[5];
+                if(value != 0){
+                    for(uint32_t i = 0; i < count; i++){
+                        const uint8_t* pair = pc + 6 + 5 * i;
+                        int32_t target = bytecode_i32(pair);
+                        dp[target] += value * (int8_t)pair[4];
+                        TOUCH(dp + target);
+                    }
+                }
+                TOUCH(dp + cell);
+                NEXT(6 + 5 * count);
+            }
+            INSTRUCTION(op_scan_right, OP_SCAN_RIGHT){
+                uint8_t stride = pc[1];
+                if(*dp != 0){
+                    dp = (CELL*)scan_right((uint8_t*)dp, tape_end, stride * sizeof(CELL), sizeof(CELL));
+                    while(*dp != 0) dp += stride;
+                }
+                TOUCH(dp);
+                NEXT(2);
+            }
+            INSTRUCTION(op_scan_left, OP_SCAN_LEFT){
+                uint8_t stride = pc[1];
+                if(*dp != 0){
+                    dp = (CELL*)scan_left((uint8_t*)dp, tape_start, stride * sizeof(CELL), sizeof(CELL));
+                    while(*dp != 0) dp -= stride;
+                }
+                NEXT(2);
+            }
+#if defined(TIERED)
+            //the native loop tests the cell itself and returns with the data pointer at the ']'
+            INSTRUCTION(op_native, OP_NATIVE){
+                RUN_NATIVE(tier->heat[pc - code->data]);
+                NEXT(2 + (int8_t)pc[1]);
+            }
+            INSTRUCTION(op_native_wide, OP_NATIVE_WIDE){
+                RUN_NATIVE(tier->heat[pc - code->data]);
+                NEXT(5 + bytecode_i32(pc + 1));
+            }
+#endif
+            INSTRUCTION(op_end, OP_END){
+                goto finished;
+            }
+#if !defined(THREADED_DISPATCH)
+            default:
+                goto finished;
+        }
+    }
+#endif
+finished:
+#if defined(PROFILE)
+    profile->high_water = high_water - (CELL*)tape->cells;
+#endif
+    return;
+}
+
+#undef COUNT_INSTRUCTION
+#undef TOUCH
+#undef RUN_NATIVE
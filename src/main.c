@@ -6,6 +6,39 @@
 #include <ctype.h>
 #include <string.h>
 #include <stdint.h>
+#include <inttypes.h>
+#include <time.h>
+
+#include <errno.h>
+#include <setjmp.h>
+#include <pthread.h>
+
+#if defined(__linux__) || (defined(__APPLE__) && defined(__MACH__))
+    #include <signal.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <fcntl.h>
+    #include <unistd.h>
+#endif
+
+#if defined(__linux__)
+    #include <elf.h>
+    #include <linux/perf_event.h>
+    #include <sys/ioctl.h>
+    #include <sys/syscall.h>
+#endif
+
+#if defined(_WIN32)
+    #include <windows.h>
+#endif
+
+#include "brainfck.h"
+
+#if defined(__AVX2__) || defined(__SSE2__)
+    #include <immintrin.h>
+#elif defined(__ARM_NEON)
+    #include <arm_neon.h>
+#endif
 
 
 /*
@@ -29,17 +62,26 @@ typedef enum {
     TOK_INPUT = ',',
     TOK_JMP_ZERO = '[',
     TOK_JMP_NON_ZERO = ']',
+    //only produced by optimize_tokens
+    TOK_SET_ZERO,
+    TOK_MUL_ADD,
+    TOK_SCAN_RIGHT,
+    TOK_SCAN_LEFT,
     TOK_INVALID
 } TokenType;
 
 
 
+//the form the optimizer and the compilers work on, the interpreters run the denser Bytecode built from it
 typedef struct { 
-    TokenType type;
+    uint8_t type; // a TokenType
+    uint32_t amount; // how often the instruction repeats, for MUL_ADD the factor as int8_t, for SCAN instructions the stride
     union {
-        uint8_t amount;
         uint32_t offset; // for JMP INSTRUCTIONS holds the index of its opening/closing counter part
+        int32_t target; // for MUL_ADD the cell relative to the data pointer that receives amount * cell
     };
+    int32_t cell; // the cell relative to the data pointer the instruction operates on
+    uint32_t position; // byte offset in the source the instruction came from, used by the profiler
 } Token;
 
 
@@ -53,21 +95,74 @@ typedef struct {
 #define MAX_PROGRAM_SIZE UINT32_MAX
 
 
+//the library is built from this file as well and must only export the functions of brainfck.h
+//everything it shares with the command line is static there, the engines and tools it has no use for are left out
+#if defined(BRAINFCK_LIBRARY)
+    #define INTERNAL static
+#else
+    #define INTERNAL
+#endif
+
+
+
+INTERNAL const char* OUT_OF_MEM = "Out of Memory\n";
+INTERNAL const char* NUMBER_WARNING = "Numbers front of Instruction %c will be ignored\nLine: %d -> %d%c\n";
+
+#define ERROR_MESSAGE_SIZE 256
+
+//library calls set a trap, errors then jump back to it with a status instead of ending the process
+typedef struct {
+#if defined(_WIN32)
+    jmp_buf jump;
+#else
+    sigjmp_buf jump; // also left from the tape fault handler, so the signal mask has to be restored
+#endif
+    BrainfckStatus status;
+    char message[ERROR_MESSAGE_SIZE];
+} Trap;
+
+#if defined(_WIN32)
+    #define TRAP_SET(trap) setjmp((trap)->jump)
+    #define TRAP_JUMP(trap) longjmp((trap)->jump, 1)
+#else
+    #define TRAP_SET(trap) sigsetjmp((trap)->jump, 1)
+    #define TRAP_JUMP(trap) siglongjmp((trap)->jump, 1)
+#endif
+
+INTERNAL _Thread_local Trap* active_trap = NULL;
 
-const char* OUT_OF_MEM = "Out of Memory\n";
-const char* NUMBER_WARNING = "Numbers front of Instruction %c will be ignored\nLine: %d -> %d%c\n";
 
-noreturn void fatal_error(const char* fmt, ...){
+INTERNAL noreturn void fatal_error_list(BrainfckStatus status, const char* fmt, va_list list){
+    if(active_trap != NULL){
+        vsnprintf(active_trap->message, sizeof(active_trap->message), fmt, list);
+        active_trap->status = status;
+        TRAP_JUMP(active_trap);
+    }
     fprintf(stderr,"Error: ");
-    va_list list;
-    va_start(list, fmt);
     vfprintf(stderr, fmt, list);
-    va_end(list);
     exit(EXIT_FAILURE);
 }
 
 
-void warning(const char* fmt, ...){
+//status is only seen by library callers
+INTERNAL noreturn void fatal_status(BrainfckStatus status, const char* fmt, ...){
+    va_list list;
+    va_start(list, fmt);
+    fatal_error_list(status, fmt, list);
+}
+
+
+//running out of memory is the only error a library call hits that is not raised with fatal_status
+INTERNAL noreturn void fatal_error(const char* fmt, ...){
+    va_list list;
+    va_start(list, fmt);
+    fatal_error_list(BRAINFCK_ERROR_MEMORY, fmt, list);
+}
+
+
+//library calls stay quiet
+INTERNAL void warning(const char* fmt, ...){
+    if(active_trap != NULL) return;
     fprintf(stderr,"Warning: ");
     va_list list;
     va_start(list, fmt);
@@ -76,7 +171,7 @@ void warning(const char* fmt, ...){
 }
 
 
-Tokens tokens_init(){
+INTERNAL Tokens tokens_init(){
     Tokens result;
     result.data = malloc(1024 * sizeof(Token));
     if(result.data == NULL) fatal_error(OUT_OF_MEM);
@@ -86,30 +181,32 @@ Tokens tokens_init(){
 }
 
 
-void tokens_append(Tokens* tokens, Token token){
+INTERNAL void tokens_append(Tokens* tokens, Token token){
     if(tokens->size == tokens->capacity){
-        tokens->capacity *=2;
-        tokens->data = realloc(tokens->data, tokens->capacity);
+        if(tokens->capacity > UINT32_MAX / 2) fatal_error(OUT_OF_MEM);
+        tokens->capacity *= 2;
+        tokens->data = realloc(tokens->data, (size_t)tokens->capacity * sizeof(Token));
         if(tokens->data == NULL) fatal_error(OUT_OF_MEM);
     }
     tokens->data[tokens->size++] = token;
 }
 
-void tokens_delete(Tokens* tokens){
+INTERNAL void tokens_delete(Tokens* tokens){
     free(tokens->data);
 }
 
 
 
 
-#define MAX_NESTED_VALUES 1000
+//grows as needed, loops nest as deep as memory allows
 typedef struct {
-    uint32_t data[MAX_NESTED_VALUES];
+    uint32_t* data;
     uint32_t size;
+    uint32_t capacity;
 } Stack;
 
 
-uint32_t stack_pop(Stack* stack){
+INTERNAL uint32_t stack_pop(Stack* stack){
     if(stack->size > 0){
         return stack->data[--stack->size];
 
@@ -119,175 +216,4632 @@ uint32_t stack_pop(Stack* stack){
 
 
 
-void stack_push(Stack* stack, uint32_t value){
-    if(stack->size < MAX_NESTED_VALUES){
-        stack->data[stack->size++] = value;
-        return;
+INTERNAL void stack_push(Stack* stack, uint32_t value){
+    if(stack->size == stack->capacity){
+        if(stack->capacity > UINT32_MAX / 2) fatal_error(OUT_OF_MEM);
+        stack->capacity = stack->capacity == 0 ? 64 : stack->capacity * 2;
+        stack->data = realloc(stack->data, (size_t)stack->capacity * sizeof(uint32_t));
+        if(stack->data == NULL) fatal_error(OUT_OF_MEM);
     }
+    stack->data[stack->size++] = value;
+}
+
 
-    fatal_error("Exceed Max Nested Scopes %d\n", MAX_NESTED_VALUES);
+INTERNAL void stack_delete(Stack* stack){
+    free(stack->data);
 }
 
 
-//tries to convert repeated instructions into a number and the instruction
-void check_continous_tokens(FILE* file, char current_char, Tokens* tokens, uint32_t number, uint32_t line){ 
-    uint32_t count = 0;
-    while(true){
-        count++;
+//source file mapped into memory (read into a buffer where mmap is not available)
+typedef struct {
+    const char* data;
+    size_t size;
+} Source;
+
 
-        fpos_t pos;
-        fgetpos(file, &pos);
-        char next_char = fgetc(file);
-        fsetpos(file, &pos);
+#if !defined(BRAINFCK_LIBRARY)
+//source_try_open returns false when the file can't be opened, source_open treats that as an error
+#if defined(__linux__) || (defined(__APPLE__) && defined(__MACH__))
+    bool source_try_open(const char* file_name, Source* result){
+        int fd = open(file_name, O_RDONLY);
+        if(fd < 0) return false;
 
-        if(next_char != current_char) break;
-        fgetc(file);
+        struct stat info;
+        if(fstat(fd, &info) != 0) fatal_error("Failed to read: %s (%s)\n", file_name, strerror(errno));
 
+        *result = (Source){NULL, info.st_size};
+        if(result->size > 0){
+            void* data = mmap(NULL, result->size, PROT_READ, MAP_PRIVATE, fd, 0);
+            if(data == MAP_FAILED) fatal_error("Failed to read: %s (%s)\n", file_name, strerror(errno));
+            madvise(data, result->size, MADV_SEQUENTIAL);
+            result->data = data;
+        }
+        close(fd);
+        return true;
     }
 
-    if(number != 0) {
-        number -= 1;
+
+    void source_close(Source* source){
+        if(source->size > 0) munmap((void*)source->data, source->size);
     }
-    uint32_t total = count + number;
+#else
+    bool source_try_open(const char* file_name, Source* result){
+        FILE* stream = fopen(file_name, "rb");
+        if(stream == NULL) return false;
 
-    if(current_char == ',' && count > 1){
-        warning("Redunant Use of Instruction ','\nLine %d: Attempting to take user input %d times without incrementing the data pointer\n", line, total);
-        total = 0;
+        size_t capacity = 4096;
+        size_t size = 0;
+        char* data = malloc(capacity);
+        if(data == NULL) fatal_error(OUT_OF_MEM);
+        while(true){
+            size += fread(data + size, 1, capacity - size, stream);
+            if(size < capacity) break;
+            capacity *= 2;
+            data = realloc(data, capacity);
+            if(data == NULL) fatal_error(OUT_OF_MEM);
+        }
+        fclose(stream);
+        *result = (Source){data, size};
+        return true;
     }
 
 
-    tokens_append(tokens, (Token){current_char, .amount=total}); 
+    void source_close(Source* source){
+        free((void*)source->data);
+    }
+#endif
+
 
+Source source_open(const char* file_name){
+    Source result;
+    if(!source_try_open(file_name, &result)) fatal_error("Failed to open: %s (%s)\n", file_name, strerror(errno));
+    return result;
 }
+#endif
 
 
+//true for every byte the lexer has to look at, instructions, digits and newlines
+INTERNAL bool is_lexeme(char c){
+    switch (c) {
+        case '>':
+        case '<':
+        case '+':
+        case '-':
+        case '.':
+        case ',':
+        case '[':
+        case ']':
+        case '\n':
+            return true;
+        default:
+            return isdigit(c);
+    }
+}
 
-#define DEFAULT_PROGAM_SIZE 1000000
 
-void interpret_progam(Tokens* tokens){
-    uint32_t cell_size = 4;
-    int8_t* cells = calloc(cell_size, 1);
-    if(cells == NULL) fatal_error(OUT_OF_MEM);
+//returns the first byte at or after current that is not a comment
+#if defined(__AVX2__)
+    INTERNAL const char* skip_comments(const char* current, const char* end){
+        while(end - current >= 32){
+            __m256i block = _mm256_loadu_si256((const __m256i*)current);
+            __m256i hits = _mm256_cmpeq_epi8(block, _mm256_set1_epi8('>'));
+            hits = _mm256_or_si256(hits, _mm256_cmpeq_epi8(block, _mm256_set1_epi8('<')));
+            hits = _mm256_or_si256(hits, _mm256_cmpeq_epi8(block, _mm256_set1_epi8('+')));
+            hits = _mm256_or_si256(hits, _mm256_cmpeq_epi8(block, _mm256_set1_epi8('-')));
+            hits = _mm256_or_si256(hits, _mm256_cmpeq_epi8(block, _mm256_set1_epi8('.')));
+            hits = _mm256_or_si256(hits, _mm256_cmpeq_epi8(block, _mm256_set1_epi8(',')));
+            hits = _mm256_or_si256(hits, _mm256_cmpeq_epi8(block, _mm256_set1_epi8('[')));
+            hits = _mm256_or_si256(hits, _mm256_cmpeq_epi8(block, _mm256_set1_epi8(']')));
+            hits = _mm256_or_si256(hits, _mm256_cmpeq_epi8(block, _mm256_set1_epi8('\n')));
+            //c - '0' <= 9 unsigned
+            __m256i digit = _mm256_sub_epi8(block, _mm256_set1_epi8('0'));
+            hits = _mm256_or_si256(hits, _mm256_cmpeq_epi8(_mm256_min_epu8(digit, _mm256_set1_epi8(9)), digit));
 
-    uint32_t dp = 0;    
-    uint32_t ip = 0;
+            uint32_t mask = _mm256_movemask_epi8(hits);
+            if(mask != 0) return current + __builtin_ctz(mask);
+            current += 32;
+        }
+        while(current < end && !is_lexeme(*current)) current++;
+        return current;
+    }
+#elif defined(__SSE2__)
+    INTERNAL const char* skip_comments(const char* current, const char* end){
+        while(end - current >= 16){
+            __m128i block = _mm_loadu_si128((const __m128i*)current);
+            __m128i hits = _mm_cmpeq_epi8(block, _mm_set1_epi8('>'));
+            hits = _mm_or_si128(hits, _mm_cmpeq_epi8(block, _mm_set1_epi8('<')));
+            hits = _mm_or_si128(hits, _mm_cmpeq_epi8(block, _mm_set1_epi8('+')));
+            hits = _mm_or_si128(hits, _mm_cmpeq_epi8(block, _mm_set1_epi8('-')));
+            hits = _mm_or_si128(hits, _mm_cmpeq_epi8(block, _mm_set1_epi8('.')));
+            hits = _mm_or_si128(hits, _mm_cmpeq_epi8(block, _mm_set1_epi8(',')));
+            hits = _mm_or_si128(hits, _mm_cmpeq_epi8(block, _mm_set1_epi8('[')));
+            hits = _mm_or_si128(hits, _mm_cmpeq_epi8(block, _mm_set1_epi8(']')));
+            hits = _mm_or_si128(hits, _mm_cmpeq_epi8(block, _mm_set1_epi8('\n')));
+            //c - '0' <= 9 unsigned
+            __m128i digit = _mm_sub_epi8(block, _mm_set1_epi8('0'));
+            hits = _mm_or_si128(hits, _mm_cmpeq_epi8(_mm_min_epu8(digit, _mm_set1_epi8(9)), digit));
 
+            uint32_t mask = _mm_movemask_epi8(hits);
+            if(mask != 0) return current + __builtin_ctz(mask);
+            current += 16;
+        }
+        while(current < end && !is_lexeme(*current)) current++;
+        return current;
+    }
+#elif defined(__ARM_NEON)
+    INTERNAL const char* skip_comments(const char* current, const char* end){
+        while(end - current >= 16){
+            uint8x16_t block = vld1q_u8((const uint8_t*)current);
+            uint8x16_t hits = vceqq_u8(block, vdupq_n_u8('>'));
+            hits = vorrq_u8(hits, vceqq_u8(block, vdupq_n_u8('<')));
+            hits = vorrq_u8(hits, vceqq_u8(block, vdupq_n_u8('+')));
+            hits = vorrq_u8(hits, vceqq_u8(block, vdupq_n_u8('-')));
+            hits = vorrq_u8(hits, vceqq_u8(block, vdupq_n_u8('.')));
+            hits = vorrq_u8(hits, vceqq_u8(block, vdupq_n_u8(',')));
+            hits = vorrq_u8(hits, vceqq_u8(block, vdupq_n_u8('[')));
+            hits = vorrq_u8(hits, vceqq_u8(block, vdupq_n_u8(']')));
+            hits = vorrq_u8(hits, vceqq_u8(block, vdupq_n_u8('\n')));
+            hits = vorrq_u8(hits, vcleq_u8(vsubq_u8(block, vdupq_n_u8('0')), vdupq_n_u8(9)));
 
-    while(ip < tokens->size){
-        Token tok = tokens->data[ip];
-        switch (tok.type) { 
+            //narrow every byte of the compare result to 4 bits of a 64 bit mask
+            uint8x8_t narrowed = vshrn_n_u16(vreinterpretq_u16_u8(hits), 4);
+            uint64_t mask = vget_lane_u64(vreinterpret_u64_u8(narrowed), 0);
+            if(mask != 0) return current + (__builtin_ctzll(mask) >> 2);
+            current += 16;
+        }
+        while(current < end && !is_lexeme(*current)) current++;
+        return current;
+    }
+#else
+    INTERNAL const char* skip_comments(const char* current, const char* end){
+        while(current < end && !is_lexeme(*current)) current++;
+        return current;
+    }
+#endif
+
+
+//a run of any length is a single token, cells are at most 32 bits so '+' and '-' can wrap the amount
+//a longer move or print than fits the amount leaves the tape or takes longer than anyone waits either way
+INTERNAL uint32_t run_amount(char instruction, uint64_t total){
+    if(total <= UINT32_MAX) return total;
+    return instruction == '+' || instruction == '-' ? total & UINT32_MAX : UINT32_MAX;
+}
+
+
+//tries to convert repeated instructions into a number and the instruction
+//returns the position after the run, or NULL when quiet and the run would need a warning
+INTERNAL const char* check_continous_tokens(const char* current, const char* end, Tokens* tokens, uint32_t number, uint32_t line, uint32_t position, bool quiet){ 
+    char current_char = *current;
+    const char* run_end = current + 1;
+    while(run_end < end && *run_end == current_char) run_end++;
+    uint32_t count = run_end - current;
+
+    if(number != 0) {
+        number -= 1;
+    }
+    uint64_t total = (uint64_t)count + number;
+
+    if(current_char == ','){
+        if(count > 1 && quiet) return NULL;
+        if(count > 1) warning("Redunant Use of Instruction ','\nLine %d: Attempting to take user input %" PRIu64 " times without incrementing the data pointer\n", line, total);
+        //input only ever reads a single byte, the amount is unused
+        total = 0;
+    }
+
+    tokens_append(tokens, (Token){current_char, .amount=run_amount(current_char, total), .position=position});
+    return run_end;
+}
+
+
+//lexes the source from begin to end into tokens, a '[' gets matched to its ']' when both are in the range
+//without closes every warning and bracket error is reported right away
+//with closes the range is lexed quietly for the parallel front end, a ']' without its '[' goes into closes
+//the '[' still open at the end stay in opens, and anything that would need a warning stops the lexing with false
+INTERNAL bool lex_range(Source* source, const char* begin, const char* end, Tokens* tokens, Stack* opens, Stack* closes){
+    bool quiet = closes != NULL;
+    uint32_t line_count = 1;
+
+    uint64_t number = 0;
+
+    const char* current = begin;
+
+    while(true){
+        current = skip_comments(current, end);
+        if(current == end) break;
+
+        char c = *current;
+        switch (c) {
             case '>':
-                if((uint64_t)dp + (uint64_t)tok.amount > MAX_PROGRAM_SIZE){
-                    fatal_error("Max Memory %d bytes Exceeded -> %d\n", MAX_PROGRAM_SIZE,(uint64_t)(dp + tok.amount));
+            case '<':
+            case '+':
+            case '-':
+            case '.':
+            case ',':
+                current = check_continous_tokens(current, end, tokens, number, line_count, current - source->data, quiet);
+                if(current == NULL) return false;
+                number = 0;
+                continue;
+            case '[':
+                if(number != 0 && quiet) return false;
+                if(number != 0) warning(NUMBER_WARNING, c, line_count, number,c, number);
+                number = 0;
+                tokens_append(tokens, (Token){c, .offset= 0, .position = current - source->data});
+                stack_push(opens, tokens->size - 1);
+                break;                     
+            case ']':
+                {
+                if(number != 0 && quiet) return false;
+                if(number != 0) warning(NUMBER_WARNING, c, line_count, number,c, number);
+                number = 0;
+                if(opens->size < 1){
+                    if(!quiet) fatal_error("Mismatched Brackets on Line %d\n", line_count); 
+                    tokens_append(tokens, (Token){c, .offset = 0, .position = current - source->data});
+                    stack_push(closes, tokens->size - 1);
+                    break;
                 }
-                dp += tok.amount;
+                 uint32_t opening_index = stack_pop(opens);
+                 Token end_bracket = {c, .offset = opening_index, .position = current - source->data};
+                 tokens_append(tokens, end_bracket);
 
-                if(dp >= cell_size){
-                    uint64_t new_size = cell_size * 2; 
-                    if(new_size > MAX_PROGRAM_SIZE){
-                        new_size = MAX_PROGRAM_SIZE;
+                 //have the offset of the opening brace point to the end_bracket index
+                 tokens->data[opening_index].offset = tokens->size - 1;
+
+                 break;
+                }
+            case '\n':
+                line_count++;
+                break;
+            default:
+                //only digits are left after skip_comments
+                while(current < end && isdigit(*current)){
+                    number = number * 10 + (*current - 48);
+                    current++;
+                    if(number > UINT32_MAX){
+                        if(quiet) return false;
+                        warning("Numbers larger than %u will be truncated to %u\nLine %d\n", UINT32_MAX, UINT32_MAX, line_count);
+                        number = UINT32_MAX;
+                        while(current < end && isdigit(*current)) current++;
                     }
-                    int8_t* tmp = realloc(cells, new_size);
-                    
-                    if(tmp == NULL) fatal_error(OUT_OF_MEM);
-                    memset(tmp + cell_size, 0, new_size - cell_size);
-                    cell_size = new_size;
-                    cells = tmp;
                 }
+                continue;
+        }
+        current++;
+    }
+    return true;
+}
+
+
+//turns the source into tokens in a single pass over the mapped file
+INTERNAL Tokens lex_source(Source* source){
+    Tokens tokens = tokens_init();
+    Stack bracket_stack = {0};
+    lex_range(source, source->data, source->data + source->size, &tokens, &bracket_stack, NULL);
+    if(bracket_stack.size != 0) fatal_error("No Final Closing Bracket\n");
+    stack_delete(&bracket_stack);
+    return tokens;
+}
+
+
+
+//largest cell offset folded into an instruction, further moves are kept as '>' or '<'
+//so cell * cell_bytes and a MUL_ADD target on top of it still fit the 32 bit displacements of the encoders
+#define MAX_FOLDED_OFFSET (1 << 24)
+
+INTERNAL bool folded_offset_fits(int64_t offset){
+    return offset >= -MAX_FOLDED_OFFSET && offset <= MAX_FOLDED_OFFSET;
+}
+
+
+#define MAX_MUL_TARGETS 32
+
+//replaces the loop starting at index start with a single instruction sequence if it is a known idiom
+//returns false if the loop has to be kept as is
+INTERNAL bool optimize_loop(Tokens* tokens, uint32_t start, Tokens* result){
+    uint32_t end = tokens->data[start].offset;
+    uint32_t position = tokens->data[start].position;
+    Token* body = tokens->data + start + 1;
+    uint32_t body_size = end - start - 1;
+
+    if(body_size == 1){
+        Token tok = body[0];
+        //[-] or [+] always reaches zero when the amount is odd
+        if((tok.type == '-' || tok.type == '+') && tok.amount % 2 == 1){
+            tokens_append(result, (Token){TOK_SET_ZERO, .amount = 0, .position = position});
+            return true;
+        }
+        //[>] or [<<] moves until it finds a zero cell, the stride is kept in a byte
+        if((tok.type == '>' || tok.type == '<') && tok.amount <= UINT8_MAX){
+            TokenType scan = tok.type == '>' ? TOK_SCAN_RIGHT : TOK_SCAN_LEFT;
+            tokens_append(result, (Token){scan, .amount = tok.amount, .position = position});
+            return true;
+        }
+    }
+
+    //[->+>++<<] adds a multiple of the current cell to other cells and then clears it
+    int32_t targets[MAX_MUL_TARGETS];
+    int64_t factors[MAX_MUL_TARGETS];
+    uint32_t target_count = 0;
+    int64_t dp = 0;
+    int64_t counter = 0;
+
+    for(uint32_t i = 0; i < body_size; i++){
+        Token tok = body[i];
+        switch (tok.type) {
+            case '>':
+                dp += tok.amount;
                 break;
             case '<':
-                if(dp - tok.amount > dp) fatal_error("Data pointer underflow\n");
                 dp -= tok.amount;
                 break;
             case '+':
-                cells[dp] += tok.amount;
-                break;
             case '-':
-                cells[dp] -= tok.amount;
-                break;
-            case '.':
-                for(int i = 0; i < tok.amount; i++){
-                    fputc(cells[dp], stdout);
+                {
+                int64_t delta = tok.type == '+' ? (int64_t)tok.amount : -(int64_t)tok.amount;
+                if(dp == 0){
+                    counter += delta;
+                    break;
                 }
+                if(!folded_offset_fits(dp)) return false;
+                uint32_t t = 0;
+                while(t < target_count && targets[t] != dp) t++;
+                if(t == target_count){
+                    if(target_count == MAX_MUL_TARGETS) return false;
+                    targets[t] = dp;
+                    factors[t] = 0;
+                    target_count++;
+                }
+                factors[t] += delta;
                 break;
-            case ',':
-                cells[dp] = fgetc(stdin);
-                break;
+                }
+            default:
+                return false;
+        }
+    }
+
+    if(dp != 0 || counter != -1) return false;
+    //the factor is stored signed so it stays exact for every cell width
+    for(uint32_t t = 0; t < target_count; t++){
+        if(factors[t] < INT8_MIN || factors[t] > INT8_MAX) return false;
+    }
+
+    for(uint32_t t = 0; t < target_count; t++){
+        if(factors[t] == 0) continue;
+        tokens_append(result, (Token){TOK_MUL_ADD, .amount = (uint8_t)factors[t], .target = targets[t], .position = position});
+    }
+    tokens_append(result, (Token){TOK_SET_ZERO, .amount = 0, .position = position});
+    return true;
+}
+
+
+//appends a bracket to the token stream and links it with its counterpart
+INTERNAL void tokens_append_bracket(Tokens* tokens, Stack* bracket_stack, Token tok){
+    if(tok.type == '['){
+        tokens_append(tokens, tok);
+        stack_push(bracket_stack, tokens->size - 1);
+        return;
+    }
+    uint32_t opening_index = stack_pop(bracket_stack);
+    tok.offset = opening_index;
+    tokens_append(tokens, tok);
+    tokens->data[opening_index].offset = tokens->size - 1;
+}
+
+
+//appends the pointer movement as '>' or '<' instructions
+//a move is at most MAX_FOLDED_OFFSET cells, so it fits the immediates of the encoders like the folded offsets
+INTERNAL void tokens_append_move(Tokens* tokens, int64_t amount, uint32_t position){
+    TokenType type = amount > 0 ? '>' : '<';
+    uint64_t remaining = amount > 0 ? amount : -amount;
+    while(remaining > 0){
+        uint32_t step = remaining > MAX_FOLDED_OFFSET ? MAX_FOLDED_OFFSET : remaining;
+        tokens_append(tokens, (Token){type, .amount = step, .position = position});
+        remaining -= step;
+    }
+}
+
+
+//rewrites loop idioms into single instructions so they no longer take O(cell value) iterations
+INTERNAL Tokens replace_loop_idioms(Tokens* tokens){
+    Tokens result = tokens_init();
+    Stack bracket_stack = {0};
+
+    for(uint32_t i = 0; i < tokens->size; i++){
+        Token tok = tokens->data[i];
+        switch (tok.type) {
             case '[':
-                if(cells[dp] == 0){ 
-                    ip = tok.offset;
+                if(optimize_loop(tokens, i, &result)){
+                    i = tok.offset;
+                    break;
                 }
+                tokens_append_bracket(&result, &bracket_stack, tok);
+                break;
+            case ']':
+                tokens_append_bracket(&result, &bracket_stack, tok);
                 break;
+            default:
+                tokens_append(&result, tok);
+                break;
+        }
+    }
+
+    stack_delete(&bracket_stack);
+    return result;
+}
+
+
+//gives every memory instruction the cell it operates on relative to the data pointer
+//so the pointer only has to be moved once per basic block, right before a jump or scan
+INTERNAL Tokens fold_pointer_moves(Tokens* tokens){
+    Tokens result = tokens_init();
+    Stack bracket_stack = {0};
+    int64_t pending = 0;
+    //the folded move is attributed to the last '>' or '<' that went into it
+    uint32_t move_position = 0;
+
+    for(uint32_t i = 0; i < tokens->size; i++){
+        Token tok = tokens->data[i];
+        switch (tok.type) {
+            case '>':
+                pending += tok.amount;
+                move_position = tok.position;
+                break;
+            case '<':
+                pending -= tok.amount;
+                move_position = tok.position;
+                break;
+            case '[':
             case ']':
-                if(cells[dp] != 0){
-                    ip = tok.offset;
+                tokens_append_move(&result, pending, move_position);
+                pending = 0;
+                tokens_append_bracket(&result, &bracket_stack, tok);
+                break;
+            case TOK_SCAN_RIGHT:
+            case TOK_SCAN_LEFT:
+                tokens_append_move(&result, pending, move_position);
+                pending = 0;
+                tokens_append(&result, tok);
+                break;
+            case TOK_MUL_ADD:
+                //a group shares its cell so it is only flushed before its first instruction
+                if(!folded_offset_fits(pending) && (i == 0 || tokens->data[i - 1].type != TOK_MUL_ADD)){
+                    tokens_append_move(&result, pending, move_position);
+                    pending = 0;
                 }
+                tok.target += pending;
+                tok.cell = pending;
+                tokens_append(&result, tok);
                 break;
-            default:     
+            default:
+                if(!folded_offset_fits(pending)){
+                    tokens_append_move(&result, pending, move_position);
+                    pending = 0;
+                }
+                tok.cell = pending;
+                tokens_append(&result, tok);
                 break;
         }
-        ip++;
+    }
+    tokens_append_move(&result, pending, move_position);
+
+    stack_delete(&bracket_stack);
+    return result;
+}
+
+
+//cells whose value the optimizer knows, by their offset from an anchor the data pointer is followed from
+//values are kept modulo 2^32, which stays exact for every cell width as long as only + and * go into them
+//the table is direct mapped, a cell pushed out by another one is just no longer known
+#define KNOWN_SLOTS 1024
+
+typedef struct {
+    int64_t cell;
+    uint32_t value;
+    uint32_t generation; // the slot only holds a value while this matches the table
+} KnownSlot;
+
+typedef struct {
+    KnownSlot slots[KNOWN_SLOTS];
+    uint32_t generation;
+    int64_t dp;
+    bool zeroed; // the anchor is the start of the progam and every cell not in the table is still zero
+    int64_t tape_cells; // cells every tape the progam may run on has, only they start out zero
+} KnownCells;
+
 
+INTERNAL KnownSlot* known_slot(KnownCells* known, int64_t cell){
+    return &known->slots[(uint64_t)cell % KNOWN_SLOTS];
+}
+
+
+//only cells on the tape are zero at the start, a read outside of it has to stay to fault
+INTERNAL bool known_get(KnownCells* known, int64_t cell, uint32_t* value){
+    KnownSlot* slot = known_slot(known, cell);
+    if(slot->generation == known->generation && slot->cell == cell){
+        *value = slot->value;
+        return true;
     }
-    free(cells);
+    *value = 0;
+    return known->zeroed && cell >= 0 && cell < known->tape_cells;
 }
 
 
+INTERNAL void known_set(KnownCells* known, int64_t cell, uint32_t value){
+    KnownSlot* slot = known_slot(known, cell);
+    //the cell pushed out would read as zero otherwise
+    if(slot->generation == known->generation && slot->cell != cell) known->zeroed = false;
+    *slot = (KnownSlot){cell, value, known->generation};
+}
 
 
+//a zeroed table can't tell a forgotten cell from a zero one, so it stops being zeroed
+INTERNAL void known_forget(KnownCells* known, int64_t cell){
+    KnownSlot* slot = known_slot(known, cell);
+    if(slot->cell == cell) slot->generation = 0;
+    known->zeroed = false;
+}
 
-#if defined(_WIN64)
-    void compile_progam(const char* file_name, const char* output_file, uint32_t size, Tokens* tokens){
-        size_t file_name_len = strlen(file_name) + 5;
-        char assembly_file[file_name_len];
 
-        char object_file[file_name_len + 7];
+//after a loop or a scan nothing is known anymore, the data pointer stays where it is as the new anchor
+INTERNAL void known_clear(KnownCells* known){
+    known->generation++;
+    known->zeroed = false;
+}
+
+
+//a known value is zero for every cell width only when it is 0, and nonzero for every width when its low byte is
+INTERNAL bool known_nonzero(uint32_t value){
+    return (value & UINT8_MAX) != 0;
+}
+
+
+//a loop is folded by running it on the known cells, with a budget per loop and for the whole progam
+#define FOLD_MAX_STEPS 4096
+#define FOLD_MAX_CELLS 64
+#define FOLD_TOTAL_STEPS (1 << 26)
 
+//a cell touched while folding a loop, cell is relative to the data pointer at the '['
+typedef struct {
+    int64_t cell;
+    uint32_t value; // when not known, what the loop added to the value the cell had before
+    bool known;
+    bool was_known; // its value before the loop was known and is in before
+    uint32_t before;
+} FoldCell;
+
+
+INTERNAL FoldCell* fold_cell(FoldCell* cells, uint32_t* count, KnownCells* known, int64_t cell){
+    for(uint32_t i = 0; i < *count; i++){
+        if(cells[i].cell == cell) return &cells[i];
+    }
+    if(*count == FOLD_MAX_CELLS || !folded_offset_fits(cell)) return NULL;
+    FoldCell* result = &cells[(*count)++];
+    result->cell = cell;
+    result->was_known = known_get(known, known->dp + cell, &result->before);
+    result->known = result->was_known;
+    result->value = result->was_known ? result->before : 0;
+    return result;
+}
+
+
+//runs the loop at index open on the known cells without emitting anything
+//it fails on io, a scan, a branch that goes another way for some cell width or a cell it knows too little about
+//cells then holds what the loop did to every cell it touched and dp where the data pointer ends, relative to the '['
+INTERNAL bool fold_loop_run(Tokens* tokens, uint32_t open, KnownCells* known, FoldCell* cells, uint32_t* cell_count, int64_t* dp, uint64_t* budget){
+    uint32_t close = tokens->data[open].offset;
+    uint32_t steps = 0;
+    int64_t at = 0;
+    *cell_count = 0;
+
+    for(uint32_t ip = open; ip <= close; ip++){
+        if(++steps > FOLD_MAX_STEPS || *budget == 0) return false;
+        (*budget)--;
+        Token tok = tokens->data[ip];
+        FoldCell* cell;
+        switch (tok.type) {
+            case '>':
+            case '<':
+                at += tok.type == '>' ? (int64_t)tok.amount : -(int64_t)tok.amount;
+                if(!folded_offset_fits(at)) return false;
+                break;
+            case '+':
+            case '-':
+                cell = fold_cell(cells, cell_count, known, at + tok.cell);
+                if(cell == NULL) return false;
+                cell->value += tok.type == '+' ? tok.amount : -tok.amount;
+                break;
+            case TOK_SET_ZERO:
+                cell = fold_cell(cells, cell_count, known, at + tok.cell);
+                if(cell == NULL) return false;
+                cell->known = true;
+                cell->value = 0;
+                break;
+            case TOK_MUL_ADD:
+                {
+                //adding value * factor is a no-op for every width the value is zero in, so the test can be left out
+                FoldCell* source = fold_cell(cells, cell_count, known, at + tok.cell);
+                if(source == NULL || !source->known) return false;
+                uint32_t value = source->value;
+                for(; tokens->data[ip].type == TOK_MUL_ADD; ip++){
+                    FoldCell* target = fold_cell(cells, cell_count, known, at + tokens->data[ip].target);
+                    if(target == NULL) return false;
+                    target->value += value * (uint32_t)(int32_t)(int8_t)tokens->data[ip].amount;
+                }
+                ip--;
+                break;
+                }
+            case '[':
+            case ']':
+                cell = fold_cell(cells, cell_count, known, at);
+                if(cell == NULL || !cell->known || (cell->value != 0 && !known_nonzero(cell->value))) return false;
+                //'[' skips to its ']' on zero and ']' goes back to its '[' otherwise
+                if((tok.type == '[') == (cell->value == 0)) ip = tok.offset;
+                break;
+            default:
+                return false;
+        }
+    }
+    *dp = at;
+    return true;
+}
+
+
+//the number of times the body of the loop at index open runs, when it counts the cell at the '[' down by one per iteration
+//starting from a known value below 256, 0 when it doesn't or the body holds loops, scans or moves by something else than 0
+INTERNAL uint32_t counted_loop_trips(Tokens* tokens, uint32_t open, uint32_t counter){
+    if(counter == 0 || counter > UINT8_MAX) return 0;
+    uint32_t close = tokens->data[open].offset;
+    int64_t at = 0;
+    uint32_t step = 0;
+    for(uint32_t i = open + 1; i < close; i++){
+        Token tok = tokens->data[i];
+        switch (tok.type) {
+            case '>':
+                at += tok.amount;
+                break;
+            case '<':
+                at -= tok.amount;
+                break;
+            case '+':
+            case '-':
+                if(at + tok.cell == 0) step += tok.type == '+' ? tok.amount : -tok.amount;
+                break;
+            case '.':
+                break;
+            case ',':
+            case TOK_SET_ZERO:
+                if(at + tok.cell == 0) return 0;
+                break;
+            case TOK_MUL_ADD:
+                if(at + tok.target == 0) return 0;
+                break;
+            default:
+                return 0;
+        }
+    }
+    return at == 0 && step == UINT32_MAX ? counter : 0;
+}
+
+
+//emits the token at index, which is not a bracket or scan, with what is known about the cells
+//a MUL_ADD group with a known cell becomes plain adds, a SET_ZERO of a zero cell is dropped
+//returns the index of the last token it took
+INTERNAL uint32_t known_emit(Tokens* result, Tokens* tokens, uint32_t index, KnownCells* known){
+    Token tok = tokens->data[index];
+    int64_t cell = known->dp + tok.cell;
+    uint32_t value;
+    bool is_known = known_get(known, cell, &value);
+    switch (tok.type) {
+        case '>':
+            known->dp += tok.amount;
+            break;
+        case '<':
+            known->dp -= tok.amount;
+            break;
+        case '+':
+        case '-':
+            if(is_known) known_set(known, cell, tok.type == '+' ? value + tok.amount : value - tok.amount);
+            break;
+        case ',':
+            known_forget(known, cell);
+            break;
+        case TOK_SET_ZERO:
+            if(is_known && value == 0) return index;
+            known_set(known, cell, 0);
+            break;
+        case TOK_MUL_ADD:
+            {
+            uint32_t end = index;
+            while(tokens->data[end].type == TOK_MUL_ADD) end++;
+            for(uint32_t i = index; i < end; i++){
+                Token add = tokens->data[i];
+                int64_t target = known->dp + add.target;
+                uint32_t target_value;
+                bool target_known = known_get(known, target, &target_value);
+                if(!is_known){
+                    tokens_append(result, add);
+                    known_forget(known, target);
+                    continue;
+                }
+                uint32_t amount = value * (uint32_t)(int32_t)(int8_t)add.amount;
+                if(amount == 0) continue;
+                tokens_append(result, (Token){'+', .amount = amount, .cell = add.target, .position = add.position});
+                if(target_known) known_set(known, target, target_value + amount);
+            }
+            return end - 1;
+            }
+        default:
+            break;
+    }
+    tokens_append(result, tok);
+    return index;
+}
+
+
+//a loop that runs a known number of times without io is repeated at most this often, a longer one keeps a loop
+//that runs the body UNROLL_FACTOR times per iteration after the iterations that don't fill a whole one
+#define MAX_UNROLLED_TOKENS 256
+#define MAX_UNROLLED_BODY 64
+#define UNROLL_FACTOR 4
+
+INTERNAL void known_emit_body(Tokens* result, Tokens* tokens, uint32_t open, KnownCells* known, uint32_t times){
+    for(uint32_t n = 0; n < times; n++){
+        for(uint32_t i = open + 1; i < tokens->data[open].offset; i++) i = known_emit(result, tokens, i, known);
+    }
+}
+
+
+//follows the known cell values through the progam, from the start where every cell is zero
+//a loop whose counter is known is run on them and replaced by adds of what it did to every cell, unless it does io
+//then the body is repeated for every iteration, or a few times per iteration if it runs too often
+//a loop on a cell that is known to be zero is left out, and constant MUL_ADD groups become adds
+INTERNAL Tokens fold_known_values(Tokens* tokens, uint64_t tape_cells){
+    Tokens result = tokens_init();
+    Stack bracket_stack = {0};
+    KnownCells* known = calloc(1, sizeof(KnownCells));
+    FoldCell* cells = malloc(FOLD_MAX_CELLS * sizeof(FoldCell));
+    if(known == NULL || cells == NULL) fatal_error(OUT_OF_MEM);
+    known->generation = 1;
+    known->zeroed = true;
+    known->tape_cells = tape_cells;
+    uint64_t budget = FOLD_TOTAL_STEPS;
+
+    for(uint32_t i = 0; i < tokens->size; i++){
+        Token tok = tokens->data[i];
+        switch (tok.type) {
+            case '[':
+                {
+                uint32_t counter;
+                if(known_get(known, known->dp, &counter)){
+                    if(counter == 0){
+                        i = tok.offset;
+                        break;
+                    }
+                    uint32_t cell_count;
+                    int64_t dp;
+                    if(known_nonzero(counter) && fold_loop_run(tokens, i, known, cells, &cell_count, &dp, &budget)){
+                        for(uint32_t c = 0; c < cell_count; c++){
+                            FoldCell cell = cells[c];
+                            uint32_t add = cell.value;
+                            if(cell.known && cell.was_known) add = cell.value - cell.before;
+                            else if(cell.known) tokens_append(&result, (Token){TOK_SET_ZERO, .cell = cell.cell, .position = tok.position});
+                            if(add != 0) tokens_append(&result, (Token){'+', .amount = add, .cell = cell.cell, .position = tok.position});
+                            if(cell.known) known_set(known, known->dp + cell.cell, cell.value);
+                            else known_forget(known, known->dp + cell.cell);
+                        }
+                        tokens_append_move(&result, dp, tok.position);
+                        known->dp += dp;
+                        i = tok.offset;
+                        break;
+                    }
+                    uint32_t trips = counted_loop_trips(tokens, i, counter);
+                    uint32_t body_size = tok.offset - i - 1;
+                    if(trips != 0 && (uint64_t)trips * body_size <= MAX_UNROLLED_TOKENS){
+                        known_emit_body(&result, tokens, i, known, trips);
+                        i = tok.offset;
+                        break;
+                    }
+                    if(trips != 0 && body_size <= MAX_UNROLLED_BODY){
+                        known_emit_body(&result, tokens, i, known, trips % UNROLL_FACTOR);
+                        if(trips >= UNROLL_FACTOR){
+                            tokens_append_bracket(&result, &bracket_stack, tok);
+                            known_clear(known);
+                            known_emit_body(&result, tokens, i, known, UNROLL_FACTOR);
+                            tokens_append_bracket(&result, &bracket_stack, tokens->data[tok.offset]);
+                            known_clear(known);
+                            known_set(known, known->dp, 0);
+                        }
+                        i = tok.offset;
+                        break;
+                    }
+                }
+                //what the body does is known for the iteration it is in, nothing holds over to the next one
+                tokens_append_bracket(&result, &bracket_stack, tok);
+                known_clear(known);
+                break;
+                }
+            case ']':
+                tokens_append_bracket(&result, &bracket_stack, tok);
+                known_clear(known);
+                known_set(known, known->dp, 0);
+                break;
+            case TOK_SCAN_RIGHT:
+            case TOK_SCAN_LEFT:
+                tokens_append(&result, tok);
+                known_clear(known);
+                known_set(known, known->dp, 0);
+                break;
+            default:
+                i = known_emit(&result, tokens, i, known);
+                break;
+        }
+    }
+
+    free(cells);
+    free(known);
+    stack_delete(&bracket_stack);
+    return result;
+}
+
+
+//the bracket offsets are recomputed for the new token stream
+//tape_cells is the fewest cells the tape the tokens run on will have
+INTERNAL Tokens optimize_tokens(Tokens* tokens, uint64_t tape_cells){
+    Tokens idioms = replace_loop_idioms(tokens);
+    Tokens folded = fold_pointer_moves(&idioms);
+    tokens_delete(&idioms);
+    Tokens result = fold_known_values(&folded, tape_cells);
+    tokens_delete(&folded);
+    return result;
+}
+
+
+//the interpreters run the tokens as bytecode, a 1 byte opcode followed by its operands
+//every opcode has a short form with 1 byte operands and a wide form with 4 byte ones for the operands that need it
+//so the common instructions take 2 or 3 bytes and large progams stay in the caches
+//the operands are little endian and unaligned, jumps hold the distance from the end of the jump
+//to the instruction after their counterpart, a MUL_ADD group is a single instruction
+typedef enum {
+    OP_MOVE, // int8 cells
+    OP_MOVE_WIDE, // int32 cells
+    OP_ADD, // int8 cell, int8 amount
+    OP_ADD_WIDE, // int32 cell, uint32 amount
+    OP_PRINT, // int8 cell
+    OP_PRINT_WIDE, // int32 cell, uint32 count
+    OP_INPUT, // int8 cell
+    OP_INPUT_WIDE, // int32 cell
+    OP_JMP_ZERO, // int8 distance
+    OP_JMP_ZERO_WIDE, // int32 distance
+    OP_JMP_NON_ZERO, // int8 distance
+    OP_JMP_NON_ZERO_WIDE, // int32 distance
+    OP_SET_ZERO, // int8 cell
+    OP_SET_ZERO_WIDE, // int32 cell
+    OP_MUL_ADD, // int8 cell, uint8 count, count times int8 target and int8 factor
+    OP_MUL_ADD_WIDE, // int32 cell, uint8 count, count times int32 target and int8 factor
+    OP_SCAN_RIGHT, // uint8 stride
+    OP_SCAN_LEFT, // uint8 stride
+    OP_NATIVE, // int8 distance, --tiered writes it over the OP_JMP_ZERO of a loop it compiled
+    OP_NATIVE_WIDE, // int32 distance
+    OP_END
+} Opcode;
+
+
+typedef struct {
+    uint8_t* data;
+    uint32_t size;
+    uint32_t* offsets; // offset of the instruction of every token and of the OP_END after them, for prerun and the profiler
+} Bytecode;
+
+
+INTERNAL bool fits_int8(int64_t value){
+    return value >= INT8_MIN && value <= INT8_MAX;
+}
+
+
+INTERNAL int32_t bytecode_i32(const uint8_t* operand){
+    int32_t value;
+    memcpy(&value, operand, 4);
+    return value;
+}
+
+
+INTERNAL void bytecode_put32(uint8_t* operand, uint32_t value){
+    memcpy(operand, &value, 4);
+}
+
+
+//the amount '+' and '-' add to the cell, the interpreters wrap it to the cell width
+INTERNAL int64_t bytecode_add_amount(Token tok){
+    return tok.type == '+' ? (int64_t)tok.amount : -(int64_t)tok.amount;
+}
+
+
+//the instruction of a MUL_ADD group is written at its first token, the others take no space
+INTERNAL bool bytecode_mul_add_narrow(Tokens* tokens, uint32_t index){
+    bool narrow = fits_int8(tokens->data[index].cell);
+    for(uint32_t i = index; i < tokens->size && tokens->data[i].type == TOK_MUL_ADD; i++){
+        narrow = narrow && fits_int8(tokens->data[i].target);
+    }
+    return narrow;
+}
+
+
+//size of the instruction of token index, the jumps are sized by short_jumps
+INTERNAL uint32_t bytecode_instruction_size(Tokens* tokens, uint32_t index, bool* short_jumps){
+    Token tok = tokens->data[index];
+    switch (tok.type) {
+        case '>':
+        case '<':
+            return tok.amount <= INT8_MAX ? 2 : 5;
+        case '+':
+        case '-':
+            return fits_int8(tok.cell) && fits_int8(bytecode_add_amount(tok)) ? 3 : 9;
+        case '.':
+            return fits_int8(tok.cell) && tok.amount == 1 ? 2 : 9;
+        case ',':
+        case TOK_SET_ZERO:
+            return fits_int8(tok.cell) ? 2 : 5;
+        case '[':
+        case ']':
+            return short_jumps[index] ? 2 : 5;
+        case TOK_MUL_ADD:
+            {
+            if(index > 0 && tokens->data[index - 1].type == TOK_MUL_ADD) return 0;
+            uint32_t count = 0;
+            while(index + count < tokens->size && tokens->data[index + count].type == TOK_MUL_ADD) count++;
+            return bytecode_mul_add_narrow(tokens, index) ? 3 + 2 * count : 6 + 5 * count;
+            }
+        default:
+            return 2;
+    }
+}
+
+
+//fills offsets with the start of every instruction and returns the size of the bytecode
+INTERNAL uint64_t bytecode_layout(Tokens* tokens, bool* short_jumps, uint32_t* offsets){
+    uint64_t size = 0;
+    for(uint32_t i = 0; i < tokens->size; i++){
+        offsets[i] = size;
+        size += bytecode_instruction_size(tokens, i, short_jumps);
+        if(size >= UINT32_MAX) fatal_error(OUT_OF_MEM);
+    }
+    offsets[tokens->size] = size;
+    return size + 1;
+}
+
+
+//distance the jump of token index covers, see Opcode
+INTERNAL int64_t bytecode_jump_distance(Tokens* tokens, bool* short_jumps, uint32_t* offsets, uint32_t index){
+    uint32_t counterpart = tokens->data[index].offset;
+    uint32_t end = offsets[index] + bytecode_instruction_size(tokens, index, short_jumps);
+    return (int64_t)offsets[counterpart + 1] - end;
+}
+
+
+//the jumps are laid out wide first, a jump that is short then stays short once the others shrink
+INTERNAL Bytecode bytecode_create(Tokens* tokens){
+    Bytecode code;
+    bool* short_jumps = calloc(tokens->size + 1, sizeof(bool));
+    code.offsets = malloc(((size_t)tokens->size + 1) * sizeof(uint32_t));
+    if(short_jumps == NULL || code.offsets == NULL) fatal_error(OUT_OF_MEM);
+
+    bytecode_layout(tokens, short_jumps, code.offsets);
+    for(uint32_t i = 0; i < tokens->size; i++){
+        TokenType type = tokens->data[i].type;
+        if(type != '[' && type != ']') continue;
+        short_jumps[i] = fits_int8(bytecode_jump_distance(tokens, short_jumps, code.offsets, i));
+    }
+    code.size = bytecode_layout(tokens, short_jumps, code.offsets);
+    code.data = malloc(code.size);
+    if(code.data == NULL) fatal_error(OUT_OF_MEM);
+
+    for(uint32_t i = 0; i < tokens->size; i++){
+        Token tok = tokens->data[i];
+        uint8_t* instruction = code.data + code.offsets[i];
+        bool wide = bytecode_instruction_size(tokens, i, short_jumps) > 3;
+        switch (tok.type) {
+            case '>':
+            case '<':
+                {
+                int32_t move = tok.type == '>' ? (int32_t)tok.amount : -(int32_t)tok.amount;
+                instruction[0] = wide ? OP_MOVE_WIDE : OP_MOVE;
+                if(wide) bytecode_put32(instruction + 1, move);
+                else instruction[1] = move;
+                break;
+                }
+            case '+':
+            case '-':
+                instruction[0] = wide ? OP_ADD_WIDE : OP_ADD;
+                if(wide){
+                    bytecode_put32(instruction + 1, tok.cell);
+                    bytecode_put32(instruction + 5, bytecode_add_amount(tok));
+                } else{
+                    instruction[1] = tok.cell;
+                    instruction[2] = bytecode_add_amount(tok);
+                }
+                break;
+            case '.':
+                instruction[0] = wide ? OP_PRINT_WIDE : OP_PRINT;
+                if(wide){
+                    bytecode_put32(instruction + 1, tok.cell);
+                    bytecode_put32(instruction + 5, tok.amount);
+                } else{
+                    instruction[1] = tok.cell;
+                }
+                break;
+            case ',':
+            case TOK_SET_ZERO:
+                if(tok.type == ',') instruction[0] = wide ? OP_INPUT_WIDE : OP_INPUT;
+                else instruction[0] = wide ? OP_SET_ZERO_WIDE : OP_SET_ZERO;
+                if(wide) bytecode_put32(instruction + 1, tok.cell);
+                else instruction[1] = tok.cell;
+                break;
+            case '[':
+            case ']':
+                {
+                int64_t distance = bytecode_jump_distance(tokens, short_jumps, code.offsets, i);
+                if(tok.type == '[') instruction[0] = short_jumps[i] ? OP_JMP_ZERO : OP_JMP_ZERO_WIDE;
+                else instruction[0] = short_jumps[i] ? OP_JMP_NON_ZERO : OP_JMP_NON_ZERO_WIDE;
+                if(short_jumps[i]) instruction[1] = distance;
+                else bytecode_put32(instruction + 1, distance);
+                break;
+                }
+            case TOK_MUL_ADD:
+                {
+                if(i > 0 && tokens->data[i - 1].type == TOK_MUL_ADD) break;
+                bool narrow = bytecode_mul_add_narrow(tokens, i);
+                uint32_t count = 0;
+                while(i + count < tokens->size && tokens->data[i + count].type == TOK_MUL_ADD) count++;
+                instruction[0] = narrow ? OP_MUL_ADD : OP_MUL_ADD_WIDE;
+                if(narrow) instruction[1] = tok.cell;
+                else bytecode_put32(instruction + 1, tok.cell);
+                uint8_t* pair = instruction + (narrow ? 3 : 6);
+                pair[-1] = count;
+                for(uint32_t j = i; j < i + count; j++){
+                    if(narrow) pair[0] = tokens->data[j].target;
+                    else bytecode_put32(pair, tokens->data[j].target);
+                    pair += narrow ? 1 : 4;
+                    *pair++ = tokens->data[j].amount;
+                }
+                break;
+                }
+            case TOK_SCAN_RIGHT:
+            case TOK_SCAN_LEFT:
+                instruction[0] = tok.type == TOK_SCAN_RIGHT ? OP_SCAN_RIGHT : OP_SCAN_LEFT;
+                instruction[1] = tok.amount;
+                break;
+        }
+    }
+    code.data[code.size - 1] = OP_END;
+    free(short_jumps);
+    return code;
+}
+
+
+INTERNAL void bytecode_delete(Bytecode* code){
+    free(code->data);
+    free(code->offsets);
+}
+
+
+
+
+#if !defined(BRAINFCK_LIBRARY)
+#define PRERUN_DEFAULT_STEPS 100000000
+#define PRERUN_MAX_CELLS 1048576 // largest tape image, a progam using more cells continues from there at runtime
+#define PRERUN_MAX_OUTPUT 16777216
+
+//state of a progam that was run ahead of time up to its first input
+//the engines print the output, copy the tape image and continue at ip
+typedef struct {
+    uint32_t ip; // token the progam continues at, the size of the progam when it finished
+    int64_t dp; // data pointer in cells
+    uint8_t* output; // bytes printed so far
+    uint32_t output_size;
+    uint8_t* tape; // cells 0 to tape_cells with cell_bytes each, all cells after them are zero
+    uint32_t tape_cells;
+} Prerun;
+
+
+bool prerun_inside(int64_t cell){
+    return cell >= 0 && cell < PRERUN_MAX_CELLS;
+}
+
+
+//true when the engines can continue at token ip, the encoders only test the cell at the start of a MUL_ADD group
+bool prerun_resumable(Tokens* tokens, uint32_t ip){
+    return ip == 0 || ip >= tokens->size || tokens->data[ip].type != TOK_MUL_ADD || tokens->data[ip - 1].type != TOK_MUL_ADD;
+}
+
+
+//runs the progam until its first ',', the step budget, or a move or access outside the cells the tape image can hold
+//it stops in front of the token that would cross one of these, running off the tape is left to the engines to report
+//a MUL_ADD group is run as a whole, so the data pointer and ip it stops at are always ones the engines can continue from
+Prerun prerun_progam(Tokens* tokens, uint32_t cell_bytes, uint64_t max_steps){
+    uint32_t mask = cell_bytes == 4 ? UINT32_MAX : (1u << 8 * cell_bytes) - 1;
+    uint32_t* cells = calloc(PRERUN_MAX_CELLS, sizeof(uint32_t));
+    uint32_t output_capacity = 4096;
+    Prerun result = {0};
+    result.output = malloc(output_capacity);
+    if(cells == NULL || result.output == NULL) fatal_error(OUT_OF_MEM);
+
+    Token* program = tokens->data;
+    int64_t dp = 0;
+    int64_t high_water = -1;
+    uint32_t ip = 0;
+    uint64_t steps = 0;
+    while(ip < tokens->size && (steps < max_steps || !prerun_resumable(tokens, ip))){
+        Token tok = program[ip];
+        int64_t cell = dp + tok.cell;
+        bool stop = false;
+        switch (tok.type) {
+            case '>':
+                stop = !prerun_inside(dp + tok.amount);
+                break;
+            case '<':
+                stop = !prerun_inside(dp - tok.amount);
+                break;
+            case ',':
+                stop = true;
+                break;
+            case '[':
+            case ']':
+            case TOK_SCAN_RIGHT:
+            case TOK_SCAN_LEFT:
+                cell = dp;
+                stop = !prerun_inside(cell);
+                break;
+            case '.':
+                stop = !prerun_inside(cell) || (uint64_t)result.output_size + tok.amount > PRERUN_MAX_OUTPUT;
+                break;
+            case TOK_MUL_ADD:
+                if(!prerun_resumable(tokens, ip)) break;
+                stop = !prerun_inside(cell);
+                for(uint32_t j = ip; program[j].type == TOK_MUL_ADD; j++){
+                    if(!prerun_inside(dp + program[j].target)) stop = true;
+                }
+                break;
+            default:
+                stop = !prerun_inside(cell);
+                break;
+        }
+
+        //a scan only counts once it stays inside, its data pointer is committed after the switch
+        int64_t scan = dp;
+        if(!stop && (tok.type == TOK_SCAN_RIGHT || tok.type == TOK_SCAN_LEFT)){
+            int32_t stride = tok.type == TOK_SCAN_RIGHT ? (int32_t)tok.amount : -(int32_t)tok.amount;
+            while(prerun_inside(scan) && cells[scan] != 0){
+                scan += stride;
+                steps++;
+            }
+            stop = !prerun_inside(scan);
+            cell = scan;
+        }
+        if(stop) break;
+        if(tok.type != '>' && tok.type != '<' && cell > high_water) high_water = cell;
+
+        switch (tok.type) {
+            case '>':
+                dp += tok.amount;
+                break;
+            case '<':
+                dp -= tok.amount;
+                break;
+            case '+':
+                cells[cell] = (cells[cell] + tok.amount) & mask;
+                break;
+            case '-':
+                cells[cell] = (cells[cell] - tok.amount) & mask;
+                break;
+            case '.':
+                while(result.output_size + tok.amount > output_capacity){
+                    output_capacity *= 2;
+                    result.output = realloc(result.output, output_capacity);
+                    if(result.output == NULL) fatal_error(OUT_OF_MEM);
+                }
+                for(uint32_t i = 0; i < tok.amount; i++) result.output[result.output_size++] = cells[cell];
+                break;
+            case '[':
+                if(cells[cell] == 0) ip = tok.offset;
+                break;
+            case ']':
+                if(cells[cell] != 0) ip = tok.offset;
+                break;
+            case TOK_SET_ZERO:
+                cells[cell] = 0;
+                break;
+            case TOK_MUL_ADD:
+                {
+                int64_t target = dp + tok.target;
+                cells[target] = (cells[target] + cells[cell] * (uint32_t)(int32_t)(int8_t)tok.amount) & mask;
+                if(target > high_water) high_water = target;
+                break;
+                }
+            case TOK_SCAN_RIGHT:
+            case TOK_SCAN_LEFT:
+                dp = scan;
+                break;
+        }
+        ip++;
+        steps++;
+    }
+
+    //trailing zero cells don't have to be copied
+    while(high_water >= 0 && cells[high_water] == 0) high_water--;
+    result.ip = ip;
+    result.dp = dp;
+    result.tape_cells = high_water + 1;
+    result.tape = malloc(result.tape_cells * cell_bytes + 1);
+    if(result.tape == NULL) fatal_error(OUT_OF_MEM);
+    for(uint32_t i = 0; i < result.tape_cells; i++){
+        switch (cell_bytes) {
+            case 1:
+                result.tape[i] = cells[i];
+                break;
+            case 2:
+                ((uint16_t*)result.tape)[i] = cells[i];
+                break;
+            case 4:
+                ((uint32_t*)result.tape)[i] = cells[i];
+                break;
+        }
+    }
+    free(cells);
+    return result;
+}
+
+
+void prerun_delete(Prerun* prerun){
+    free(prerun->output);
+    free(prerun->tape);
+}
+
+
+
+
+#define HASH_SEED 0xcbf29ce484222325
+
+//FNV-1a over 8 byte words, only used to notice a changed source or a damaged cache
+//hash_continue carries on from an earlier hash so several buffers can be hashed as one
+uint64_t hash_continue(uint64_t hash, const void* data, size_t size){
+    const uint8_t* bytes = data;
+    for(; size >= 8; size -= 8, bytes += 8){
+        uint64_t word;
+        memcpy(&word, bytes, 8);
+        hash = (hash ^ word) * 0x100000001b3;
+    }
+    for(; size > 0; size--, bytes++){
+        hash = (hash ^ *bytes) * 0x100000001b3;
+    }
+    return hash;
+}
+
+
+uint64_t hash_bytes(const void* data, size_t size){
+    return hash_continue(HASH_SEED, data, size);
+}
+
+
+//the optimized tokens of a source are kept in a .bfc file and used directly on later runs
+//the file is the header followed by the token array exactly as it is in memory
+//with --prerun the output and tape image of the prerun follow, the cell width and step budget are part of the key
+//BFC_VERSION has to change with the Token layout or anything the lexer and optimizer produce
+#define BFC_VERSION 6
+typedef struct {
+    char magic[4]; // "BFC" and a 0
+    uint32_t version;
+    uint32_t token_size;
+    uint32_t token_count;
+    uint64_t source_size;
+    uint64_t source_hash;
+    uint64_t data_hash; // the header with data_hash set to 0 and everything after it
+    uint64_t prerun_steps; // 0 without a prerun
+    uint32_t cell_bytes; // only set with a prerun
+    uint32_t resume_ip;
+    int64_t resume_dp;
+    uint32_t output_size;
+    uint32_t tape_cells;
+} CacheHeader;
+
+
+//hash of the header and the data behind it, the resume fields are trusted as much as the tokens
+//the tokens, the prerun output and the tape image are hashed one after the other, so they never have to be copied together
+uint64_t cache_hash(CacheHeader header, const Token* tokens, const uint8_t* output, const uint8_t* tape){
+    uint64_t tape_size = (uint64_t)header.tape_cells * header.cell_bytes;
+    header.data_hash = 0;
+    uint64_t hash = hash_continue(hash_bytes(&header, sizeof(header)), tokens, (size_t)header.token_count * sizeof(Token));
+    hash = hash_continue(hash, output, header.output_size);
+    return hash_continue(hash, tape, tape_size);
+}
+
+
+//checks that every token can be executed, the engines trust the types, the bracket offsets
+//and the limits the optimizer keeps to: folded offsets and moves, byte strides and MUL_ADD groups on one cell ending in its SET_ZERO
+bool cache_tokens_valid(Tokens* tokens){
+    for(uint32_t i = 0; i < tokens->size; i++){
+        Token tok = tokens->data[i];
+        if(!folded_offset_fits(tok.cell)) return false;
+        switch (tok.type) {
+            case '>':
+            case '<':
+                if(tok.amount > MAX_FOLDED_OFFSET) return false;
+                break;
+            case '+':
+            case '-':
+            case '.':
+            case ',':
+            case TOK_SET_ZERO:
+                break;
+            case TOK_MUL_ADD:
+                {
+                if(i > 0 && tokens->data[i - 1].type == TOK_MUL_ADD) break;
+                uint32_t end = i;
+                while(end < tokens->size && tokens->data[end].type == TOK_MUL_ADD){
+                    if(tokens->data[end].cell != tok.cell || !folded_offset_fits(tokens->data[end].target)) return false;
+                    end++;
+                }
+                if(end - i > MAX_MUL_TARGETS || end == tokens->size) return false;
+                if(tokens->data[end].type != TOK_SET_ZERO || tokens->data[end].cell != tok.cell) return false;
+                break;
+                }
+            case TOK_SCAN_RIGHT:
+            case TOK_SCAN_LEFT:
+                if(tok.amount > UINT8_MAX) return false;
+                break;
+            case '[':
+            case ']':
+                {
+                char counterpart = tok.type == '[' ? ']' : '[';
+                if(tok.offset >= tokens->size) return false;
+                Token other = tokens->data[tok.offset];
+                if(other.type != counterpart || other.offset != i) return false;
+                if((tok.type == '[') != (tok.offset > i)) return false;
+                break;
+                }
+            default:
+                return false;
+        }
+    }
+    return true;
+}
+
+
+//maps the tokens of cache_file into program if it was written for this exact source and prerun options
+//the tokens and the prerun point into cache, which has to stay open as long as they are used
+bool cache_load(const char* cache_file, Source* source, Source* cache, Tokens* program, uint64_t prerun_steps, uint32_t cell_bytes, Prerun* prerun){
+    if(!source_try_open(cache_file, cache)) return false;
+
+    CacheHeader header;
+    bool valid = cache->size >= sizeof(header);
+    if(valid){
+        memcpy(&header, cache->data, sizeof(header));
+        uint64_t tokens_size = (uint64_t)header.token_count * sizeof(Token);
+        uint64_t data_size = tokens_size + header.output_size + (uint64_t)header.tape_cells * header.cell_bytes;
+        const uint8_t* data = (const uint8_t*)cache->data + sizeof(header);
+        valid = memcmp(header.magic, "BFC", 4) == 0 && header.version == BFC_VERSION && header.token_size == sizeof(Token)
+            && cache->size == sizeof(header) + data_size
+            && header.prerun_steps == prerun_steps && header.cell_bytes == (prerun_steps != 0 ? cell_bytes : 0)
+            && header.resume_ip <= header.token_count && prerun_inside(header.resume_dp)
+            && header.tape_cells <= PRERUN_MAX_CELLS && header.output_size <= PRERUN_MAX_OUTPUT
+            && header.source_size == source->size && header.source_hash == hash_bytes(source->data, source->size)
+            && header.data_hash == cache_hash(header, (const Token*)data, data + tokens_size, data + tokens_size + header.output_size);
+    }
+    if(valid){
+        program->data = (Token*)(cache->data + sizeof(header));
+        program->size = header.token_count;
+        program->capacity = header.token_count;
+        valid = cache_tokens_valid(program) && prerun_resumable(program, header.resume_ip);
+    }
+    if(valid && prerun_steps != 0){
+        prerun->ip = header.resume_ip;
+        prerun->dp = header.resume_dp;
+        prerun->output = (uint8_t*)(program->data + program->size);
+        prerun->output_size = header.output_size;
+        prerun->tape = prerun->output + prerun->output_size;
+        prerun->tape_cells = header.tape_cells;
+    }
+
+    if(!valid) source_close(cache);
+    return valid;
+}
+
+
+//writes the cache next to the source, a failed write only costs the next run a parse
+//the file is written under a temporary name and renamed, so no run ever maps half of it
+void cache_write(const char* cache_file, Source* source, Tokens* program, uint64_t prerun_steps, uint32_t cell_bytes, Prerun* prerun){
+    CacheHeader header = {
+        .magic = "BFC",
+        .version = BFC_VERSION,
+        .token_size = sizeof(Token),
+        .token_count = program->size,
+        .source_size = source->size,
+        .source_hash = hash_bytes(source->data, source->size),
+        .prerun_steps = prerun_steps,
+    };
+    if(prerun_steps != 0){
+        header.cell_bytes = cell_bytes;
+        header.resume_ip = prerun->ip;
+        header.resume_dp = prerun->dp;
+        header.output_size = prerun->output_size;
+        header.tape_cells = prerun->tape_cells;
+    }
+
+    size_t tokens_size = program->size * sizeof(Token);
+    size_t tape_size = (size_t)header.tape_cells * header.cell_bytes;
+    header.data_hash = cache_hash(header, program->data, prerun->output, prerun->tape);
+
+    char temporary_file[strlen(cache_file) + 5];
+    sprintf(temporary_file, "%s.tmp", cache_file);
+    FILE* stream = fopen(temporary_file, "wb");
+    if(stream == NULL){
+        warning("Failed to write cache: %s (%s)\n", temporary_file, strerror(errno));
+        return;
+    }
+    bool written = fwrite(&header, sizeof(header), 1, stream) == 1;
+    if(tokens_size > 0) written = written && fwrite(program->data, 1, tokens_size, stream) == tokens_size;
+    if(header.output_size > 0) written = written && fwrite(prerun->output, 1, header.output_size, stream) == header.output_size;
+    if(tape_size > 0) written = written && fwrite(prerun->tape, 1, tape_size, stream) == tape_size;
+    written = fclose(stream) == 0 && written;
+
+#if defined(_WIN32)
+    //rename does not replace an existing file on windows
+    remove(cache_file);
+#endif
+    if(!written || rename(temporary_file, cache_file) != 0){
+        warning("Failed to write cache: %s\n", cache_file);
+        remove(temporary_file);
+    }
+}
+#endif
+
+
+
+#define DEFAULT_PROGAM_SIZE 1000000
+//cells the command line optimizes for, the tape of every cell width and backend has at least that many
+//so the same tokens can be cached for all of them, the win64 compiler only has DEFAULT_PROGAM_SIZE bytes
+#if defined(_WIN64)
+    #define CLI_TAPE_CELLS (DEFAULT_PROGAM_SIZE / sizeof(uint32_t))
+#else
+    #define CLI_TAPE_CELLS (MAX_PROGRAM_SIZE / sizeof(uint32_t))
+#endif
+#define IO_BUFFER_SIZE 65536 // size of the output and input buffers in compiled programs and the interpreter
+
+
+#define GUARD_ALIGNMENT 65536 // guards are rounded to the largest page size compiled programs may run with
+
+//largest distance past the end of the tape an access can land without an earlier access in between
+//every access is at most max offset away from the data pointer and the pointer only moves
+//by a run of '>'/'<' or a scan step between accesses, cell_bytes scales the distance in cells to bytes
+INTERNAL uint64_t tape_guard_size(Tokens* tokens, uint32_t cell_bytes){
+    uint64_t max_offset = 0;
+    uint64_t max_move = UINT8_MAX;
+    uint64_t move = 0;
+
+    for(uint32_t i = 0; i < tokens->size; i++){
+        Token tok = tokens->data[i];
+        if(tok.type == '>' || tok.type == '<'){
+            move += tok.amount;
+            if(move > max_move) max_move = move;
+            continue;
+        }
+        move = 0;
+
+        uint64_t cell = tok.cell < 0 ? -(int64_t)tok.cell : tok.cell;
+        if(cell > max_offset) max_offset = cell;
+        if(tok.type == TOK_MUL_ADD){
+            uint64_t target = tok.target < 0 ? -(int64_t)tok.target : tok.target;
+            if(target > max_offset) max_offset = target;
+        }
+    }
+
+    uint64_t guard = (2 * max_offset + max_move) * cell_bytes;
+    return (guard / GUARD_ALIGNMENT + 1) * GUARD_ALIGNMENT;
+}
+
+
+//tapes are whole guard alignments, a size that already is one stays as it is
+INTERNAL uint64_t tape_rounded_size(uint64_t size){
+    return (size + GUARD_ALIGNMENT - 1) / GUARD_ALIGNMENT * GUARD_ALIGNMENT;
+}
+
+
+#define TAPE_UNKNOWN INT64_MIN
+
+//abstract interpretation of the data pointer relative to where the progam starts
+//a loop whose body moves it by zero, and only holds loops like that and no scan, leaves it where it was
+//so up to the first other loop or scan the pointer every token sees is known, from there on nothing is
+//positions gets it for every token, TAPE_UNKNOWN for the ones past that point
+//returns true when the whole progam is known and never touches a cell left of the start
+//cells then is one past the highest cell it can touch, a tape of that size is never left
+INTERNAL bool tape_bounds(Tokens* tokens, int64_t* positions, uint64_t* cells){
+    int64_t* known = positions != NULL ? positions : malloc(((size_t)tokens->size + 1) * sizeof(int64_t));
+    if(known == NULL) fatal_error(OUT_OF_MEM);
+
+    //walks the tokens as if every loop ran once, which is right for the loops that move by zero
+    int64_t position = 0;
+    uint32_t stop = tokens->size;
+    int64_t last_unknown = -1; // latest scan or loop that leaves the pointer unknown
+    for(uint32_t i = 0; i < tokens->size; i++){
+        Token tok = tokens->data[i];
+        known[i] = position;
+        if(tok.type == '>') position += tok.amount;
+        else if(tok.type == '<') position -= tok.amount;
+        else if(tok.type == TOK_SCAN_RIGHT || tok.type == TOK_SCAN_LEFT){
+            //it reads every cell up to the zero it stops at
+            if(i < stop) stop = i;
+            last_unknown = i;
+        } else if(tok.type == ']' && (position != known[tok.offset] || last_unknown > (int64_t)tok.offset)){
+            //the '[' still tests the cell it was entered on
+            if(tok.offset + 1 < stop) stop = tok.offset + 1;
+            last_unknown = i;
+        }
+    }
+
+    int64_t low = 0;
+    int64_t high = -1;
+    for(uint32_t i = 0; i < stop; i++){
+        Token tok = tokens->data[i];
+        int64_t cell = known[i] + tok.cell;
+        switch (tok.type) {
+            case '>':
+            case '<':
+                continue;
+            case '[':
+            case ']':
+                cell = known[i];
+                break;
+            case TOK_MUL_ADD:
+                {
+                int64_t target = known[i] + tok.target;
+                if(target < low) low = target;
+                if(target > high) high = target;
+                break;
+                }
+            default:
+                break;
+        }
+        if(cell < low) low = cell;
+        if(cell > high) high = cell;
+    }
+    for(uint32_t i = stop; i < tokens->size; i++) known[i] = TAPE_UNKNOWN;
+    if(positions == NULL) free(known);
+
+    *cells = high + 1;
+    return stop == tokens->size && low >= 0;
+}
+
+
+//bytes of tape the progam needs, just enough for its highest cell when tape_bounds knows it
+//every tape keeps its guards, so a progam that isn't known still faults on leaving it
+INTERNAL uint64_t tape_size_needed(Tokens* tokens, uint32_t cell_bytes){
+    uint64_t cells;
+    if(!tape_bounds(tokens, NULL, &cells) || cells > MAX_PROGRAM_SIZE / cell_bytes) return MAX_PROGRAM_SIZE;
+    return cells > 0 ? cells * cell_bytes : cell_bytes;
+}
+
+
+//the tape is one large reserved region with inaccessible guard regions on both ends
+//pages only get backed by memory once they are touched, so engines can run without bounds checks
+//and an access outside the tape is caught as a fault and reported
+typedef struct {
+    uint8_t* memory; // whole region including the guards
+    uint64_t memory_size;
+    int8_t* cells;
+    uint64_t size;
+    uint64_t limit; // size that was asked for, reported when the progam goes past it
+} Tape;
+
+
+//input and output of an interpreter run
+//output is collected in buffer and written out whenever it fills up or before input is read
+typedef struct {
+    FILE* input; // read with fgetc when set
+    int (*read)(void* context); // otherwise read through this when set
+    const uint8_t* input_data; // otherwise read in place, the end of it reads as end of input
+    uint64_t input_size;
+    uint64_t input_position;
+    FILE* output; // the buffer is written to it when set
+    size_t (*write)(void* context, const uint8_t* data, size_t size); // or handed to this
+    void* context;
+    uint8_t* buffer; // with neither of them it keeps the whole output, growing unless it belongs to the caller
+    uint64_t size;
+    uint64_t capacity;
+    bool fixed; // buffer belongs to the caller and can't grow
+    uint64_t written; // bytes written out so far
+    uint64_t consumed; // bytes read so far, the end of the input not counted
+    uint64_t limit; // most bytes a run may write, 0 for no limit
+} Io;
+
+
+#if !defined(BRAINFCK_LIBRARY)
+Io io_create(FILE* input, FILE* output){
+    Io io = {.input = input, .output = output, .capacity = IO_BUFFER_SIZE};
+    io.buffer = malloc(io.capacity);
+    if(io.buffer == NULL) fatal_error(OUT_OF_MEM);
+    return io;
+}
+#endif
+
+
+//a limit is only checked when the buffer is written out, a little more output than allowed can be produced before that
+INTERNAL void io_flush(Io* io){
+    if(io->output == NULL && io->write == NULL) return;
+    uint64_t size = io->size;
+    bool exceeded = io->limit != 0 && io->written + size > io->limit;
+    if(exceeded) size = io->limit - io->written;
+
+    if(io->output != NULL) fwrite(io->buffer, 1, size, io->output);
+    else if(io->write(io->context, io->buffer, size) != size) fatal_status(BRAINFCK_ERROR_OUTPUT, "Failed to write the output\n");
+    io->written += size;
+    io->size = 0;
+    if(exceeded) fatal_status(BRAINFCK_ERROR_OUTPUT_LIMIT, "Output limit of %" PRIu64 " bytes exceeded\n", io->limit);
+}
+
+
+//makes room for at least one more byte
+INTERNAL void io_grow(Io* io){
+    if(io->output != NULL || io->write != NULL){
+        io_flush(io);
+        return;
+    }
+    if(io->fixed || (io->limit != 0 && io->size >= io->limit)){
+        fatal_status(BRAINFCK_ERROR_OUTPUT_LIMIT, "Output limit of %" PRIu64 " bytes exceeded\n", io->fixed ? io->capacity : io->limit);
+    }
+    io->capacity *= 2;
+    if(io->limit != 0 && io->capacity > io->limit) io->capacity = io->limit;
+    io->buffer = realloc(io->buffer, io->capacity);
+    if(io->buffer == NULL) fatal_error(OUT_OF_MEM);
+}
+
+
+INTERNAL void io_write(Io* io, uint8_t byte){
+    if(io->size == io->capacity) io_grow(io);
+    io->buffer[io->size++] = byte;
+}
+
+
+//pending output goes out first so prompts show up before the progam waits for input
+INTERNAL int io_read(Io* io){
+    if(io->size > 0) io_flush(io);
+    int c;
+    if(io->input != NULL) c = fgetc(io->input);
+    else if(io->read != NULL) c = io->read(io->context);
+    else if(io->input_position == io->input_size) c = EOF;
+    else c = io->input_data[io->input_position++];
+    if(c < 0) return EOF;
+    io->consumed++;
+    return c;
+}
+
+
+INTERNAL void io_delete(Io* io){
+    if(!io->fixed) free(io->buffer);
+}
+
+
+//every thread running a progam has its own tape, faults are always delivered to the thread that caused them
+INTERNAL _Thread_local Tape* guarded_tape = NULL;
+INTERNAL _Thread_local Io* guarded_io = NULL;
+
+
+INTERNAL void tape_report_fault(uint8_t* address){
+    //the fault comes from a cell access in an engine, never from inside stdio, so flushing is safe
+    //a library run gives its output to the caller once it is back from the trap
+    if(active_trap == NULL){
+        if(guarded_io != NULL) io_flush(guarded_io);
+        fflush(stdout);
+    }
+    if(address < (uint8_t*)guarded_tape->cells) fatal_status(BRAINFCK_ERROR_TAPE_UNDERFLOW, "Data pointer underflow\n");
+    fatal_status(BRAINFCK_ERROR_TAPE_LIMIT, "Max Memory %" PRIu64 " bytes Exceeded\n", guarded_tape->limit);
+}
+
+
+#if defined(__linux__) || (defined(__APPLE__) && defined(__MACH__))
+    //handlers that were installed before ours, a program embedding the library may have its own
+    INTERNAL struct sigaction previous_segv;
+    INTERNAL struct sigaction previous_bus;
+    INTERNAL pthread_once_t tape_handler_once = PTHREAD_ONCE_INIT;
+
+    INTERNAL void tape_fault(int signal_number, siginfo_t* info, void* context){
+        uint8_t* address = info->si_addr;
+        if(guarded_tape != NULL && address >= guarded_tape->memory && address < guarded_tape->memory + guarded_tape->memory_size){
+            tape_report_fault(address);
+        }
+        //not caused by the tape, hand it to the previous handler or fault again with the default action
+        struct sigaction* previous = signal_number == SIGSEGV ? &previous_segv : &previous_bus;
+        if(previous->sa_flags & SA_SIGINFO){
+            previous->sa_sigaction(signal_number, info, context);
+        } else if(previous->sa_handler != SIG_DFL && previous->sa_handler != SIG_IGN){
+            previous->sa_handler(signal_number);
+        } else{
+            signal(signal_number, SIG_DFL);
+        }
+    }
+
+
+    INTERNAL void tape_install_handler(){
+        struct sigaction action = {0};
+        action.sa_sigaction = tape_fault;
+        action.sa_flags = SA_SIGINFO;
+        sigemptyset(&action.sa_mask);
+        sigaction(SIGSEGV, &action, &previous_segv);
+        sigaction(SIGBUS, &action, &previous_bus);
+    }
+
+
+    INTERNAL Tape tape_create(uint64_t size, uint64_t guard){
+        Tape tape;
+        tape.limit = size;
+        size = tape_rounded_size(size);
+        tape.memory_size = guard + size + guard;
+
+        int flags = MAP_PRIVATE | MAP_ANONYMOUS;
+        #if defined(MAP_NORESERVE)
+            flags |= MAP_NORESERVE;
+        #endif
+        tape.memory = mmap(NULL, tape.memory_size, PROT_NONE, flags, -1, 0);
+        if(tape.memory == MAP_FAILED) fatal_error(OUT_OF_MEM);
+
+        tape.cells = (int8_t*)tape.memory + guard;
+        tape.size = size;
+        if(mprotect(tape.cells, size, PROT_READ | PROT_WRITE) != 0) fatal_error(OUT_OF_MEM);
+
+        pthread_once(&tape_handler_once, tape_install_handler);
+        return tape;
+    }
+
+
+    #if !defined(BRAINFCK_LIBRARY)
+    //mapping fresh pages over the cells zeroes them and gives back the memory the last run touched
+    void tape_clear(Tape* tape){
+        int flags = MAP_PRIVATE | MAP_ANONYMOUS | MAP_FIXED;
+        #if defined(MAP_NORESERVE)
+            flags |= MAP_NORESERVE;
+        #endif
+        if(mmap(tape->cells, tape->size, PROT_READ | PROT_WRITE, flags, -1, 0) == MAP_FAILED) fatal_error(OUT_OF_MEM);
+    }
+    #endif
+
+
+    INTERNAL void tape_delete(Tape* tape){
+        munmap(tape->memory, tape->memory_size);
+    }
+#elif defined(_WIN32)
+    //windows has no lazily backed mappings, tape pages are committed by the exception handler on first touch
+    INTERNAL _Thread_local PVOID tape_handler = NULL;
+
+    INTERNAL LONG WINAPI tape_fault(EXCEPTION_POINTERS* exception){
+        EXCEPTION_RECORD* record = exception->ExceptionRecord;
+        if(record->ExceptionCode != EXCEPTION_ACCESS_VIOLATION || guarded_tape == NULL) return EXCEPTION_CONTINUE_SEARCH;
+
+        uint8_t* address = (uint8_t*)record->ExceptionInformation[1];
+        uint8_t* cells = (uint8_t*)guarded_tape->cells;
+        if(address >= cells && address < cells + guarded_tape->size){
+            if(VirtualAlloc(address, 1, MEM_COMMIT, PAGE_READWRITE) == NULL) fatal_error(OUT_OF_MEM);
+            return EXCEPTION_CONTINUE_EXECUTION;
+        }
+        if(address >= guarded_tape->memory && address < guarded_tape->memory + guarded_tape->memory_size){
+            tape_report_fault(address);
+        }
+        return EXCEPTION_CONTINUE_SEARCH;
+    }
+
+
+    INTERNAL Tape tape_create(uint64_t size, uint64_t guard){
+        Tape tape;
+        tape.limit = size;
+        size = tape_rounded_size(size);
+        tape.memory_size = guard + size + guard;
+        tape.memory = VirtualAlloc(NULL, tape.memory_size, MEM_RESERVE, PAGE_NOACCESS);
+        if(tape.memory == NULL) fatal_error(OUT_OF_MEM);
+        tape.cells = (int8_t*)tape.memory + guard;
+        tape.size = size;
+        tape_handler = AddVectoredExceptionHandler(1, tape_fault);
+        return tape;
+    }
+
+
+    #if !defined(BRAINFCK_LIBRARY)
+    //decommitted pages read as zero once the handler commits them again
+    void tape_clear(Tape* tape){
+        VirtualFree(tape->cells, tape->size, MEM_DECOMMIT);
+    }
+    #endif
+
+
+    INTERNAL void tape_delete(Tape* tape){
+        RemoveVectoredExceptionHandler(tape_handler);
+        VirtualFree(tape->memory, 0, MEM_RELEASE);
+    }
+#endif
+
+
+//scans search a block of width bytes at once for a zero cell
+//a block gives a mask with bits per byte, the lanes are the bits of the first byte of every cell the scan visits
+//right scans start at the first byte of the block, left scans at the last cell of the block
+#define SCAN_MIN_LANES 4 // wide strides visit too few cells per block to beat the one cell at a time loop
+INTERNAL uint32_t scan_lane_count(uint32_t width, uint32_t byte_stride, uint32_t cell_bytes){
+    return (width - cell_bytes) / byte_stride + 1;
+}
+
+
+INTERNAL uint64_t scan_lanes(uint32_t width, uint32_t bits, uint32_t byte_stride, uint32_t cell_bytes, bool left){
+    uint64_t lanes = 0;
+    for(uint32_t i = 0; i + cell_bytes <= width; i += byte_stride){
+        lanes |= 1ull << (left ? width - cell_bytes - i : i) * bits;
+    }
+    return lanes;
+}
+
+
+//returns a mask with SCAN_BITS set for every zero byte of the SCAN_WIDTH bytes at block
+#if defined(__AVX2__)
+    #define SCAN_WIDTH 32
+    #define SCAN_BITS 1
+    INTERNAL uint64_t zero_bytes(const uint8_t* block){
+        __m256i hits = _mm256_cmpeq_epi8(_mm256_loadu_si256((const __m256i*)block), _mm256_setzero_si256());
+        return (uint32_t)_mm256_movemask_epi8(hits);
+    }
+#elif defined(__SSE2__)
+    #define SCAN_WIDTH 16
+    #define SCAN_BITS 1
+    INTERNAL uint64_t zero_bytes(const uint8_t* block){
+        __m128i hits = _mm_cmpeq_epi8(_mm_loadu_si128((const __m128i*)block), _mm_setzero_si128());
+        return (uint32_t)_mm_movemask_epi8(hits);
+    }
+#elif defined(__ARM_NEON)
+    #define SCAN_WIDTH 16
+    #define SCAN_BITS 4
+    INTERNAL uint64_t zero_bytes(const uint8_t* block){
+        uint8x16_t hits = vceqq_u8(vld1q_u8(block), vdupq_n_u8(0));
+        //narrow every byte of the compare result to 4 bits of a 64 bit mask
+        uint8x8_t narrowed = vshrn_n_u16(vreinterpretq_u16_u8(hits), 4);
+        return vget_lane_u64(vreinterpret_u64_u8(narrowed), 0);
+    }
+#endif
+
+
+#if defined(SCAN_WIDTH)
+    //keeps the bits of the first byte of every cell whose bytes are all zero
+    INTERNAL uint64_t zero_cells(uint64_t mask, uint32_t cell_bytes){
+        if(cell_bytes >= 2) mask &= mask >> SCAN_BITS;
+        if(cell_bytes == 4) mask &= mask >> 2 * SCAN_BITS;
+        return mask;
+    }
+#endif
+
+
+//scan_right and scan_left return the first zero cell of the scan starting at the non zero cell p
+//or the cell the interpreter has to continue from one cell at a time
+//blocks are only loaded inside the tape, so running off it still ends in a guard region and gets reported
+INTERNAL uint8_t* scan_right(uint8_t* p, const uint8_t* end, uint32_t byte_stride, uint32_t cell_bytes){
+    if(byte_stride == 1){
+        uint8_t* zero = memchr(p, 0, end - p);
+        return zero != NULL ? zero : (uint8_t*)end;
+    }
+#if defined(SCAN_WIDTH)
+    uint32_t lane_count = scan_lane_count(SCAN_WIDTH, byte_stride, cell_bytes);
+    if(lane_count < SCAN_MIN_LANES) return p;
+    uint64_t lanes = scan_lanes(SCAN_WIDTH, SCAN_BITS, byte_stride, cell_bytes, false);
+    while(end - p >= SCAN_WIDTH){
+        uint64_t hits = zero_cells(zero_bytes(p), cell_bytes) & lanes;
+        if(hits != 0) return p + __builtin_ctzll(hits) / SCAN_BITS;
+        p += lane_count * byte_stride;
+    }
+#else
+    (void)cell_bytes;
+#endif
+    return p;
+}
+
+
+INTERNAL uint8_t* scan_left(uint8_t* p, const uint8_t* start, uint32_t byte_stride, uint32_t cell_bytes){
+#if defined(SCAN_WIDTH)
+    uint32_t lane_count = scan_lane_count(SCAN_WIDTH, byte_stride, cell_bytes);
+    if(lane_count < SCAN_MIN_LANES) return p;
+    uint64_t lanes = scan_lanes(SCAN_WIDTH, SCAN_BITS, byte_stride, cell_bytes, true);
+    //the block ends with the last byte of the cell at p
+    while(p + cell_bytes - start >= SCAN_WIDTH){
+        uint8_t* block = p + cell_bytes - SCAN_WIDTH;
+        uint64_t hits = zero_cells(zero_bytes(block), cell_bytes) & lanes;
+        if(hits != 0) return block + (63 - __builtin_clzll(hits)) / SCAN_BITS;
+        p -= lane_count * byte_stride;
+    }
+#else
+    (void)start;
+    (void)byte_stride;
+    (void)cell_bytes;
+#endif
+    return p;
+}
+
+
+//with gcc and clang the interpreter uses threaded dispatch: every handler looks up the handler
+//of the next opcode and jumps straight to it
+//this removes the bounds check per instruction and gives every handler its own indirect branch
+//other compilers fall back to a switch
+//NEXT moves pc over size bytes, COUNT_INSTRUCTION is defined by interpreter.h and only does something in the profiling build
+#if defined(__GNUC__)
+    #define THREADED_DISPATCH
+    #define INSTRUCTION(label, opcode) label: COUNT_INSTRUCTION();
+    #define NEXT(size) pc += (size); goto *handlers[*pc]
+#else
+    #define INSTRUCTION(label, opcode) case opcode: COUNT_INSTRUCTION();
+    #define NEXT(size) pc += (size); continue
+#endif
+
+
+#if !defined(BRAINFCK_LIBRARY)
+//execution counts gathered by the --profile interpreter
+typedef struct {
+    uint64_t* counts; // executions per instruction, indexed by its offset in the bytecode
+    uint64_t high_water; // highest cell index the program touched
+} Profile;
+
+
+//true for the tokens that run exactly when the MUL_ADD in front of them does, the jit only counts the first of a group for --stats
+bool stats_follows_group(Tokens* tokens, uint32_t index){
+    Token tok = tokens->data[index];
+    return (tok.type == TOK_MUL_ADD || tok.type == TOK_SET_ZERO) && index > 0 && tokens->data[index - 1].type == TOK_MUL_ADD;
+}
+
+
+#if defined(__x86_64__) && (defined(__linux__) || (defined(__APPLE__) && defined(__MACH__)))
+    //--tiered starts in the interpreter and hands a loop to the jit once it jumped back TIER_THRESHOLD times
+    //the native loop runs on the same tape, it takes the tape and the byte offset of the data pointer and returns where it ended
+    #define TIERED_JIT
+    #define TIER_THRESHOLD 4096
+
+    typedef uint64_t (*NativeLoop)(uint8_t* cells, uint64_t dp);
+
+    typedef struct {
+        uint8_t* memory;
+        size_t size;
+        NativeLoop run;
+    } TierLoop;
+
+    typedef struct {
+        Tokens* tokens;
+        Bytecode* code; // a copy of its own, compiled loops are patched into it
+        Io* io;
+        uint64_t tape_size;
+        uint32_t cell_bytes;
+        uint32_t* heat; // back jumps of the ']' at every offset, and the TierLoop of a compiled '[' at its offset
+        TierLoop* loops;
+        uint32_t loop_count;
+        uint32_t loop_capacity;
+    } Tier;
+
+    uint32_t tier_compile(Tier* tier, uint32_t jump);
+
+    #define TIERED
+    #define CELL uint8_t
+    #define INTERPRET_PROGAM tiered_progam_8
+    #include "interpreter.h"
+    #undef CELL
+    #undef INTERPRET_PROGAM
+
+    #define CELL uint16_t
+    #define INTERPRET_PROGAM tiered_progam_16
+    #include "interpreter.h"
+    #undef CELL
+    #undef INTERPRET_PROGAM
+
+    #define CELL uint32_t
+    #define INTERPRET_PROGAM tiered_progam_32
+    #include "interpreter.h"
+    #undef CELL
+    #undef INTERPRET_PROGAM
+    #undef TIERED
+#endif
+
+#define CELL uint8_t
+#define INTERPRET_PROGAM interpret_progam_8
+#include "interpreter.h"
+#undef CELL
+#undef INTERPRET_PROGAM
+
+#define CELL uint16_t
+#define INTERPRET_PROGAM interpret_progam_16
+#include "interpreter.h"
+#undef CELL
+#undef INTERPRET_PROGAM
+
+#define CELL uint32_t
+#define INTERPRET_PROGAM interpret_progam_32
+#include "interpreter.h"
+#undef CELL
+#undef INTERPRET_PROGAM
+
+#define PROFILE
+#define CELL uint8_t
+#define INTERPRET_PROGAM profile_progam_8
+#include "interpreter.h"
+#undef CELL
+#undef INTERPRET_PROGAM
+
+#define CELL uint16_t
+#define INTERPRET_PROGAM profile_progam_16
+#include "interpreter.h"
+#undef CELL
+#undef INTERPRET_PROGAM
+
+#define CELL uint32_t
+#define INTERPRET_PROGAM profile_progam_32
+#include "interpreter.h"
+#undef CELL
+#undef INTERPRET_PROGAM
+#undef PROFILE
+#endif
+
+#define LIMITED
+#define CELL uint8_t
+#define INTERPRET_PROGAM limited_progam_8
+#include "interpreter.h"
+#undef CELL
+#undef INTERPRET_PROGAM
+
+#define CELL uint16_t
+#define INTERPRET_PROGAM limited_progam_16
+#include "interpreter.h"
+#undef CELL
+#undef INTERPRET_PROGAM
+
+#define CELL uint32_t
+#define INTERPRET_PROGAM limited_progam_32
+#include "interpreter.h"
+#undef CELL
+#undef INTERPRET_PROGAM
+#undef LIMITED
+
+#undef INSTRUCTION
+#undef NEXT
+
+
+#if !defined(BRAINFCK_LIBRARY)
+//runs the progam on a fresh or cleared tape, prerun is NULL to run the progam from the start
+void run_progam(Bytecode* code, uint32_t cell_bytes, Tape* tape, Io* io, Prerun* prerun){
+    switch (cell_bytes) {
+        case 1:
+            interpret_progam_8(code, tape, io, prerun);
+            break;
+        case 2:
+            interpret_progam_16(code, tape, io, prerun);
+            break;
+        case 4:
+            interpret_progam_32(code, tape, io, prerun);
+            break;
+    }
+}
+
+
+void interpret_progam(Tokens* tokens, uint32_t cell_bytes, Prerun* prerun){
+    Tape tape = tape_create(tape_size_needed(tokens, cell_bytes), tape_guard_size(tokens, cell_bytes));
+    Io io = io_create(stdin, stdout);
+    Bytecode code = bytecode_create(tokens);
+    guarded_tape = &tape;
+    guarded_io = &io;
+
+    run_progam(&code, cell_bytes, &tape, &io, prerun);
+    io_flush(&io);
+
+    guarded_tape = NULL;
+    guarded_io = NULL;
+    bytecode_delete(&code);
+    io_delete(&io);
+    tape_delete(&tape);
+}
+
+
+#define PROFILE_REPORT_ROWS 10
+
+//line and column of a byte offset in the source, both starting at 1
+void source_location(Source* source, uint32_t position, uint32_t* line, uint32_t* column){
+    uint32_t line_start = 0;
+    *line = 1;
+    for(uint32_t i = 0; i < position && i < source->size; i++){
+        if(source->data[i] == '\n'){
+            (*line)++;
+            line_start = i + 1;
+        }
+    }
+    *column = position - line_start + 1;
+}
+
+
+const char* token_name(Token tok){
+    switch (tok.type) {
+        case '>': return ">";
+        case '<': return "<";
+        case '+': return "+";
+        case '-': return "-";
+        case '.': return ".";
+        case ',': return ",";
+        case '[': return "[";
+        case ']': return "]";
+        case TOK_SET_ZERO: return "set zero";
+        case TOK_MUL_ADD: return "multiply add";
+        case TOK_SCAN_RIGHT: return "scan right";
+        case TOK_SCAN_LEFT: return "scan left";
+    }
+    return "?";
+}
+
+
+typedef struct {
+    uint32_t open; // index of the '[' token
+    uint64_t self; // tokens executed in the loop but outside of its inner loops
+    uint64_t total; // tokens executed in the loop including inner loops
+} LoopProfile;
+
+
+int compare_loops(const void* a, const void* b){
+    uint64_t self_a = ((const LoopProfile*)a)->self;
+    uint64_t self_b = ((const LoopProfile*)b)->self;
+    return self_a < self_b ? 1 : self_a > self_b ? -1 : 0;
+}
+
+
+typedef struct {
+    uint32_t index;
+    uint64_t count;
+} TokenCount;
+
+
+int compare_token_counts(const void* a, const void* b){
+    uint64_t count_a = ((const TokenCount*)a)->count;
+    uint64_t count_b = ((const TokenCount*)b)->count;
+    return count_a < count_b ? 1 : count_a > count_b ? -1 : 0;
+}
+
+
+//ranks the loops by the tokens executed directly inside of them and the single hottest tokens
+//loops the optimizer replaced by a single instruction show up as that instruction
+//a token is counted as often as its instruction ran, every token of a MUL_ADD group shares one
+void profile_report(Tokens* tokens, Bytecode* code, Profile* profile, Source* source){
+    uint64_t* counts = malloc((tokens->size + 1) * sizeof(uint64_t));
+    if(counts == NULL) fatal_error(OUT_OF_MEM);
+    for(uint32_t i = 0; i < tokens->size; i++) counts[i] = profile->counts[code->offsets[i]];
+    uint64_t executed = 0;
+    uint32_t loop_count = 0;
+    for(uint32_t i = 0; i < tokens->size; i++){
+        executed += counts[i];
+        if(tokens->data[i].type == '[') loop_count++;
+    }
+
+    LoopProfile* loops = malloc((loop_count + 1) * sizeof(LoopProfile));
+    TokenCount* order = malloc((tokens->size + 1) * sizeof(TokenCount));
+    if(loops == NULL || order == NULL) fatal_error(OUT_OF_MEM);
+
+    Stack open_loops = {0};
+    uint32_t loop_index = 0;
+    for(uint32_t i = 0; i < tokens->size; i++){
+        Token tok = tokens->data[i];
+        if(tok.type == '['){
+            loops[loop_index] = (LoopProfile){i, 0, 0};
+            stack_push(&open_loops, loop_index++);
+        }
+        if(open_loops.size > 0) loops[open_loops.data[open_loops.size - 1]].self += counts[i];
+        if(tok.type == ']'){
+            uint32_t closed = stack_pop(&open_loops);
+            loops[closed].total += loops[closed].self;
+            if(open_loops.size > 0) loops[open_loops.data[open_loops.size - 1]].total += loops[closed].total;
+        }
+    }
+    stack_delete(&open_loops);
+    qsort(loops, loop_count, sizeof(LoopProfile), compare_loops);
+
+    fprintf(stderr, "\nProfile\n");
+    fprintf(stderr, "%" PRIu64 " instructions executed, tape high-water mark %" PRIu64 " cells\n", executed, profile->high_water + 1);
+
+    double percent = executed > 0 ? 100.0 / executed : 0;
+    fprintf(stderr, "\nHot loops\n");
+    fprintf(stderr, "%-4s  %-12s  %14s  %14s  %16s  %16s  %6s\n", "rank", "line:col", "entries", "iterations", "self", "total", "self %");
+    for(uint32_t l = 0; l < loop_count && l < PROFILE_REPORT_ROWS; l++){
+        LoopProfile loop = loops[l];
+        if(loop.total == 0) break;
+        uint32_t line, column;
+        source_location(source, tokens->data[loop.open].position, &line, &column);
+        char location[32];
+        snprintf(location, sizeof(location), "%u:%u", line, column);
+        uint32_t close = tokens->data[loop.open].offset;
+        fprintf(stderr, "%-4u  %-12s  %14" PRIu64 "  %14" PRIu64 "  %16" PRIu64 "  %16" PRIu64 "  %6.2f\n",
+                l + 1, location, counts[loop.open], counts[close], loop.self, loop.total, loop.self * percent);
+    }
+
+    for(uint32_t i = 0; i < tokens->size; i++) order[i] = (TokenCount){i, counts[i]};
+    qsort(order, tokens->size, sizeof(TokenCount), compare_token_counts);
+
+    fprintf(stderr, "\nHot instructions\n");
+    fprintf(stderr, "%-4s  %-12s  %-14s  %16s  %6s\n", "rank", "line:col", "instruction", "executions", "%");
+    for(uint32_t r = 0; r < tokens->size && r < PROFILE_REPORT_ROWS; r++){
+        uint32_t i = order[r].index;
+        if(counts[i] == 0) break;
+        uint32_t line, column;
+        source_location(source, tokens->data[i].position, &line, &column);
+        char location[32];
+        snprintf(location, sizeof(location), "%u:%u", line, column);
+        fprintf(stderr, "%-4u  %-12s  %-14s  %16" PRIu64 "  %6.2f\n", r + 1, location, token_name(tokens->data[i]), counts[i], counts[i] * percent);
+    }
+
+    free(order);
+    free(loops);
+    free(counts);
+}
+
+
+//runs the program on the counting interpreter and prints the report to stderr once it finishes
+void profile_progam(Tokens* tokens, uint32_t cell_bytes, Source* source){
+    Bytecode code = bytecode_create(tokens);
+    Profile profile = {0};
+    profile.counts = calloc(code.size, sizeof(uint64_t));
+    if(profile.counts == NULL) fatal_error(OUT_OF_MEM);
+
+    Tape tape = tape_create(tape_size_needed(tokens, cell_bytes), tape_guard_size(tokens, cell_bytes));
+    Io io = io_create(stdin, stdout);
+    guarded_tape = &tape;
+    guarded_io = &io;
+
+    switch (cell_bytes) {
+        case 1:
+            profile_progam_8(&code, &tape, &io, &profile);
+            break;
+        case 2:
+            profile_progam_16(&code, &tape, &io, &profile);
+            break;
+        case 4:
+            profile_progam_32(&code, &tape, &io, &profile);
+            break;
+    }
+    io_flush(&io);
+
+    guarded_tape = NULL;
+    guarded_io = NULL;
+    io_delete(&io);
+    tape_delete(&tape);
+
+    fflush(stdout);
+    profile_report(tokens, &code, &profile, source);
+    free(profile.counts);
+    bytecode_delete(&code);
+}
+
+
+
+
+
+uint32_t cpu_count(){
+#if defined(_WIN32)
+    SYSTEM_INFO info;
+    GetSystemInfo(&info);
+    return info.dwNumberOfProcessors;
+#else
+    long count = sysconf(_SC_NPROCESSORS_ONLN);
+    return count > 0 ? count : 1;
+#endif
+}
+
+
+//the parallel front end splits a large source into one chunk per thread and lexes the chunks at the same time
+//every chunk starts right after an instruction, so no number in front of an instruction is cut off from it
+//a run the cut goes through is merged back into a single token afterwards
+//brackets are matched inside each chunk, the ones left over are matched by their nesting depth
+//where the depth a chunk starts at is the prefix sum of how much the chunks before it opened
+//anything only the serial lexer reports, a warning or a bracket error, has the whole source lexed again by it
+//so messages and their line numbers stay the same
+
+//smaller chunks are lexed faster than a thread starts
+#define LEX_CHUNK_MIN_SIZE (1 << 20)
+
+typedef struct {
+    Source* source;
+    const char* begin;
+    const char* end;
+    Tokens tokens;
+    Stack opens; // '[' of the chunk still open at its end
+    Stack closes; // ']' of the chunk opened in an earlier one
+    bool lexed; // false when the chunk needs the serial lexer
+    uint32_t skip; // 1 when the first token was merged into the run the chunks before ended with
+    uint32_t shift; // index in the whole progam minus the index in the chunk
+    uint64_t depth; // nesting depth at the start of the chunk
+    Token* destination;
+} LexChunk;
+
+
+//a '[' whose ']' is in a later chunk, its offset is written relative to the chunk like all others
+typedef struct {
+    Token* token;
+    uint32_t index;
+    uint32_t shift;
+} OpenBracket;
+
+
+void* lex_chunk(void* argument){
+    LexChunk* chunk = argument;
+    chunk->tokens = tokens_init();
+    chunk->lexed = lex_range(chunk->source, chunk->begin, chunk->end, &chunk->tokens, &chunk->opens, &chunk->closes);
+    return NULL;
+}
+
+
+//moves the tokens of a chunk to their place in the whole progam
+void* lex_chunk_copy(void* argument){
+    LexChunk* chunk = argument;
+    for(uint32_t i = chunk->skip; i < chunk->tokens.size; i++){
+        Token tok = chunk->tokens.data[i];
+        if(tok.type == '[' || tok.type == ']') tok.offset += chunk->shift;
+        chunk->destination[chunk->shift + i] = tok;
+    }
+    return NULL;
+}
+
+
+void lex_chunks_run(LexChunk* chunks, uint32_t count, void* (*work)(void*)){
+    pthread_t handles[count];
+    for(uint32_t i = 0; i < count; i++){
+        if(pthread_create(&handles[i], NULL, work, &chunks[i]) != 0) fatal_error("Failed to start lexer thread\n");
+    }
+    for(uint32_t i = 0; i < count; i++) pthread_join(handles[i], NULL);
+}
+
+
+//stitches the lexed chunks together, returns false when the serial lexer has to report something
+bool lex_chunks_join(LexChunk* chunks, uint32_t count, Tokens* result){
+    const char* data = chunks[0].source->data;
+    Token* last = NULL;
+    uint64_t size = 0;
+    uint64_t depth = 0;
+    uint64_t max_depth = 0;
+    for(uint32_t c = 0; c < count; c++){
+        LexChunk* chunk = &chunks[c];
+        if(!chunk->lexed) return false;
+
+        chunk->skip = 0;
+        if(chunk->tokens.size > 0 && last != NULL){
+            Token* first = &chunk->tokens.data[0];
+            bool run = first->type != '[' && first->type != ']';
+            if(run && first->position == (uint32_t)(chunk->begin - data) && first->type == chunk->begin[-1]){
+                //the ',' warning counts the whole run
+                if(first->type == ',') return false;
+                last->amount = run_amount(first->type, (uint64_t)last->amount + first->amount);
+                chunk->skip = 1;
+            }
+        }
+        if(size + chunk->tokens.size - chunk->skip > UINT32_MAX) fatal_error(OUT_OF_MEM);
+        chunk->shift = size - chunk->skip;
+        size += chunk->tokens.size - chunk->skip;
+        if(chunk->tokens.size > chunk->skip) last = &chunk->tokens.data[chunk->tokens.size - 1];
+
+        if(chunk->closes.size > depth) return false;
+        chunk->depth = depth;
+        depth = depth - chunk->closes.size + chunk->opens.size;
+        if(depth > max_depth) max_depth = depth;
+    }
+    if(depth != 0) return false;
+
+    //pending[d] is the '[' left open at depth d, the next ']' that gets back to depth d closes it
+    OpenBracket* pending = malloc((max_depth + 1) * sizeof(OpenBracket));
+    if(pending == NULL) fatal_error(OUT_OF_MEM);
+    for(uint32_t c = 0; c < count; c++){
+        LexChunk* chunk = &chunks[c];
+        Token* tokens = chunk->tokens.data;
+        for(uint32_t i = 0; i < chunk->closes.size; i++){
+            uint32_t close = chunk->closes.data[i];
+            OpenBracket open = pending[chunk->depth - 1 - i];
+            tokens[close].offset = open.index - chunk->shift;
+            open.token->offset = close + chunk->shift - open.shift;
+        }
+        uint64_t open_depth = chunk->depth - chunk->closes.size;
+        for(uint32_t i = 0; i < chunk->opens.size; i++){
+            uint32_t open = chunk->opens.data[i];
+            pending[open_depth + i] = (OpenBracket){&tokens[open], open + chunk->shift, chunk->shift};
+        }
+    }
+    free(pending);
+
+    result->data = malloc((size + 1) * sizeof(Token));
+    if(result->data == NULL) fatal_error(OUT_OF_MEM);
+    result->size = size;
+    result->capacity = size + 1;
+    for(uint32_t c = 0; c < count; c++) chunks[c].destination = result->data;
+    lex_chunks_run(chunks, count, lex_chunk_copy);
+    return true;
+}
+
+
+//lex_source on up to threads threads, small sources are lexed on the calling one
+Tokens lex_source_parallel(Source* source, uint32_t threads){
+    uint64_t count = source->size / LEX_CHUNK_MIN_SIZE;
+    if(count > threads) count = threads;
+    if(count < 2) return lex_source(source);
+
+    LexChunk chunks[count];
+    const char* end = source->data + source->size;
+    const char* begin = source->data;
+    for(uint32_t c = 0; c < count; c++){
+        const char* cut = end;
+        if(c + 1 < count){
+            cut = source->data + source->size / count * (c + 1);
+            if(cut < begin) cut = begin;
+            cut = skip_comments(cut, end);
+            while(cut < end && (isdigit(*cut) || *cut == '\n')) cut = skip_comments(cut + 1, end);
+            if(cut < end) cut++;
+        }
+        chunks[c] = (LexChunk){.source = source, .begin = begin, .end = cut};
+        begin = cut;
+    }
+
+    lex_chunks_run(chunks, count, lex_chunk);
+    Tokens result;
+    bool joined = lex_chunks_join(chunks, count, &result);
+    for(uint32_t c = 0; c < count; c++){
+        tokens_delete(&chunks[c].tokens);
+        stack_delete(&chunks[c].opens);
+        stack_delete(&chunks[c].closes);
+    }
+    return joined ? result : lex_source(source);
+}
+
+
+
+
+
+//--batch runs many progams and inputs listed in a manifest on a pool of threads
+//every line is {progam file} [{input file}] [{output file}], an input of - or none runs without input
+//without an output file the output goes to stdout, in manifest order either way
+typedef struct {
+    char* input_file; // NULL runs without input
+    char* output_file; // NULL writes to stdout
+    uint32_t program; // index into the programs of the batch
+    uint32_t line;
+    Io io; // the whole output of the run, kept until it is written
+    bool done;
+    BrainfckStatus status; // a run that failed keeps the output it printed before and the error
+    char message[ERROR_MESSAGE_SIZE];
+} BatchRun;
+
+
+//every worker starts with its share of the runs, takes its own from the front
+//and steals from the back of the others once it runs out
+typedef struct {
+    pthread_mutex_t lock;
+    uint32_t* runs;
+    uint32_t front;
+    uint32_t back;
+} BatchQueue;
+
+
+typedef struct {
+    Bytecode* programs; // built once, the workers only read them
+    uint32_t program_count;
+    BatchRun* runs;
+    uint32_t run_count;
+    BatchQueue* queues;
+    uint32_t worker_count;
+    uint32_t cell_bytes;
+    uint64_t guard; // largest tape guard any of the programs needs
+    pthread_mutex_t lock; // protects the done flags of the runs
+    pthread_cond_t finished;
+} Batch;
+
+
+typedef struct {
+    Batch* batch;
+    uint32_t index;
+} BatchWorker;
+
+
+bool batch_next(Batch* batch, uint32_t worker, uint32_t* run){
+    for(uint32_t i = 0; i < batch->worker_count; i++){
+        BatchQueue* queue = &batch->queues[(worker + i) % batch->worker_count];
+        pthread_mutex_lock(&queue->lock);
+        bool found = queue->front < queue->back;
+        if(found) *run = i == 0 ? queue->runs[queue->front++] : queue->runs[--queue->back];
+        pthread_mutex_unlock(&queue->lock);
+        if(found) return true;
+    }
+    return false;
+}
+
+
+void* batch_worker(void* argument){
+    BatchWorker* worker = argument;
+    Batch* batch = worker->batch;
+    Tape tape = tape_create(MAX_PROGRAM_SIZE, batch->guard);
+    guarded_tape = &tape;
+
+    bool used = false;
+    uint32_t index;
+    while(batch_next(batch, worker->index, &index)){
+        BatchRun* run = &batch->runs[index];
+        if(used) tape_clear(&tape);
+        used = true;
+
+        Bytecode* program = &batch->programs[run->program];
+        run->io = io_create(NULL, NULL);
+        if(run->input_file != NULL) run->io.input = fopen(run->input_file, "rb");
+
+        //an error only ends this run, the trap brings the worker back here with its status
+        Trap trap = {0};
+        if(run->input_file != NULL && run->io.input == NULL){
+            trap.status = BRAINFCK_ERROR_ARGUMENT;
+            snprintf(trap.message, sizeof(trap.message), "Failed to open input %s: %s\n", run->input_file, strerror(errno));
+        } else{
+            active_trap = &trap;
+            if(TRAP_SET(&trap) == 0){
+                guarded_io = &run->io;
+                run_progam(program, batch->cell_bytes, &tape, &run->io, NULL);
+            }
+            active_trap = NULL;
+            guarded_io = NULL;
+        }
+        run->status = trap.status;
+        memcpy(run->message, trap.message, sizeof(run->message));
+        if(run->io.input != NULL) fclose(run->io.input);
+
+        pthread_mutex_lock(&batch->lock);
+        run->done = true;
+        pthread_cond_broadcast(&batch->finished);
+        pthread_mutex_unlock(&batch->lock);
+    }
+
+    guarded_tape = NULL;
+    tape_delete(&tape);
+    return NULL;
+}
+
+
+//copies the next whitespace separated field of the line, NULL once the line has no more
+char* manifest_field(const char** cursor, const char* end){
+    const char* start = *cursor;
+    while(start < end && isspace((unsigned char)*start)) start++;
+    const char* stop = start;
+    while(stop < end && !isspace((unsigned char)*stop)) stop++;
+    *cursor = stop;
+    if(stop == start) return NULL;
+
+    char* field = malloc(stop - start + 1);
+    if(field == NULL) fatal_error(OUT_OF_MEM);
+    memcpy(field, start, stop - start);
+    field[stop - start] = '\0';
+    return field;
+}
+
+
+//reads the manifest into runs, program_files gets every distinct progam once
+//returns the number of runs, lines that are empty or start with # are skipped
+uint32_t manifest_read(const char* manifest_file, BatchRun** runs, char*** program_files, uint32_t* program_count){
+    Source manifest = source_open(manifest_file);
+    uint32_t run_capacity = 64;
+    uint32_t run_count = 0;
+    *runs = malloc(run_capacity * sizeof(BatchRun));
+
+    //open addressing table from progam file to its index, grown to stay at most half full
+    uint32_t table_capacity = 64;
+    uint32_t* table = malloc(table_capacity * sizeof(uint32_t));
+    uint32_t program_capacity = 16;
+    *program_files = malloc(program_capacity * sizeof(char*));
+    *program_count = 0;
+    if(*runs == NULL || table == NULL || *program_files == NULL) fatal_error(OUT_OF_MEM);
+    memset(table, 0xFF, table_capacity * sizeof(uint32_t));
+
+    const char* line = manifest.data;
+    const char* data_end = manifest.data + manifest.size;
+    uint32_t line_number = 0;
+    while(line < data_end){
+        const char* end = memchr(line, '\n', data_end - line);
+        if(end == NULL) end = data_end;
+        line_number++;
+
+        const char* cursor = line;
+        char* program_file = manifest_field(&cursor, end);
+        line = end + 1;
+        if(program_file == NULL) continue;
+        if(program_file[0] == '#'){
+            free(program_file);
+            continue;
+        }
+        char* input_file = manifest_field(&cursor, end);
+        char* output_file = manifest_field(&cursor, end);
+        char* extra = manifest_field(&cursor, end);
+        if(extra != NULL) fatal_error("%s:%u: expected {progam file} [{input file}] [{output file}]\n", manifest_file, line_number);
+        if(input_file != NULL && strcmp(input_file, "-") == 0){
+            free(input_file);
+            input_file = NULL;
+        }
+
+        uint32_t slot = hash_bytes(program_file, strlen(program_file)) & (table_capacity - 1);
+        while(table[slot] != UINT32_MAX && strcmp((*program_files)[table[slot]], program_file) != 0){
+            slot = (slot + 1) & (table_capacity - 1);
+        }
+        uint32_t program;
+        if(table[slot] == UINT32_MAX){
+            if(*program_count == program_capacity){
+                program_capacity *= 2;
+                *program_files = realloc(*program_files, program_capacity * sizeof(char*));
+                if(*program_files == NULL) fatal_error(OUT_OF_MEM);
+            }
+            program = (*program_count)++;
+            table[slot] = program;
+            (*program_files)[program] = program_file;
+
+            if(*program_count * 2 > table_capacity){
+                table_capacity *= 2;
+                table = realloc(table, table_capacity * sizeof(uint32_t));
+                if(table == NULL) fatal_error(OUT_OF_MEM);
+                memset(table, 0xFF, table_capacity * sizeof(uint32_t));
+                for(uint32_t i = 0; i < *program_count; i++){
+                    char* file = (*program_files)[i];
+                    uint32_t rehashed = hash_bytes(file, strlen(file)) & (table_capacity - 1);
+                    while(table[rehashed] != UINT32_MAX) rehashed = (rehashed + 1) & (table_capacity - 1);
+                    table[rehashed] = i;
+                }
+            }
+        } else{
+            program = table[slot];
+            free(program_file);
+        }
+
+        if(run_count == run_capacity){
+            run_capacity *= 2;
+            *runs = realloc(*runs, run_capacity * sizeof(BatchRun));
+            if(*runs == NULL) fatal_error(OUT_OF_MEM);
+        }
+        (*runs)[run_count++] = (BatchRun){
+            .input_file = input_file,
+            .output_file = output_file,
+            .program = program,
+            .line = line_number,
+        };
+    }
+
+    free(table);
+    source_close(&manifest);
+    return run_count;
+}
+
+
+//every distinct progam is parsed once, the runs share its tokens
+//returns false when any run failed, the other runs still finish and write their output
+bool batch_progams(const char* manifest_file, uint32_t cell_bytes, uint32_t threads){
+    Batch batch = {.cell_bytes = cell_bytes};
+    char** program_files;
+    batch.run_count = manifest_read(manifest_file, &batch.runs, &program_files, &batch.program_count);
+    if(batch.run_count == 0){
+        free(batch.runs);
+        free(program_files);
+        return true;
+    }
+
+    batch.programs = malloc(batch.program_count * sizeof(Bytecode));
+    if(batch.programs == NULL) fatal_error(OUT_OF_MEM);
+    for(uint32_t i = 0; i < batch.program_count; i++){
+        Source source = source_open(program_files[i]);
+        Tokens tokens = lex_source_parallel(&source, threads);
+        Tokens optimized = optimize_tokens(&tokens, CLI_TAPE_CELLS);
+        batch.programs[i] = bytecode_create(&optimized);
+        uint64_t guard = tape_guard_size(&optimized, cell_bytes);
+        if(guard > batch.guard) batch.guard = guard;
+        tokens_delete(&optimized);
+        tokens_delete(&tokens);
+        source_close(&source);
+    }
+
+    //runs are dealt out round robin so they tend to finish in manifest order
+    batch.worker_count = threads < batch.run_count ? threads : batch.run_count;
+    batch.queues = malloc(batch.worker_count * sizeof(BatchQueue));
+    uint32_t* queued = malloc(batch.run_count * sizeof(uint32_t));
+    BatchWorker* workers = malloc(batch.worker_count * sizeof(BatchWorker));
+    pthread_t* handles = malloc(batch.worker_count * sizeof(pthread_t));
+    if(batch.queues == NULL || queued == NULL || workers == NULL || handles == NULL) fatal_error(OUT_OF_MEM);
+
+    uint32_t next = 0;
+    for(uint32_t w = 0; w < batch.worker_count; w++){
+        BatchQueue* queue = &batch.queues[w];
+        pthread_mutex_init(&queue->lock, NULL);
+        queue->runs = queued + next;
+        queue->front = 0;
+        queue->back = 0;
+        for(uint32_t i = w; i < batch.run_count; i += batch.worker_count) queue->runs[queue->back++] = i;
+        next += queue->back;
+    }
+    pthread_mutex_init(&batch.lock, NULL);
+    pthread_cond_init(&batch.finished, NULL);
+
+    for(uint32_t w = 0; w < batch.worker_count; w++){
+        workers[w] = (BatchWorker){.batch = &batch, .index = w};
+        if(pthread_create(&handles[w], NULL, batch_worker, &workers[w]) != 0) fatal_error("Failed to start batch worker\n");
+    }
+
+    //outputs are written as soon as every run in front of them is done
+    bool succeeded = true;
+    for(uint32_t i = 0; i < batch.run_count; i++){
+        BatchRun* run = &batch.runs[i];
+        pthread_mutex_lock(&batch.lock);
+        while(!run->done) pthread_cond_wait(&batch.finished, &batch.lock);
+        pthread_mutex_unlock(&batch.lock);
+
+        if(run->output_file != NULL){
+            FILE* output = fopen(run->output_file, "wb");
+            if(output == NULL || fwrite(run->io.buffer, 1, run->io.size, output) != run->io.size){
+                warning("%s:%u: failed to write %s\n", manifest_file, run->line, run->output_file);
+            }
+            if(output != NULL) fclose(output);
+        } else{
+            fwrite(run->io.buffer, 1, run->io.size, stdout);
+        }
+        if(run->status != BRAINFCK_OK){
+            fflush(stdout);
+            fprintf(stderr, "Error: %s:%u: %s", manifest_file, run->line, run->message);
+            succeeded = false;
+        }
+        io_delete(&run->io);
+        free(run->input_file);
+        free(run->output_file);
+    }
+    fflush(stdout);
+
+    //idle workers still look into the other queues, so the locks go only once all of them stopped
+    for(uint32_t w = 0; w < batch.worker_count; w++) pthread_join(handles[w], NULL);
+    for(uint32_t w = 0; w < batch.worker_count; w++) pthread_mutex_destroy(&batch.queues[w].lock);
+    pthread_mutex_destroy(&batch.lock);
+    pthread_cond_destroy(&batch.finished);
+
+    for(uint32_t i = 0; i < batch.program_count; i++){
+        bytecode_delete(&batch.programs[i]);
+        free(program_files[i]);
+    }
+    free(program_files);
+    free(batch.programs);
+    free(batch.runs);
+    free(batch.queues);
+    free(queued);
+    free(workers);
+    free(handles);
+    return succeeded;
+}
+#endif
+
+
+
+
+
+//the library api declared in brainfck.h
+struct BrainfckProgram {
+    Bytecode code;
+    uint32_t cell_bytes;
+    uint64_t guard;
+    BrainfckOptions options;
+};
+
+
+INTERNAL _Thread_local char error_message[ERROR_MESSAGE_SIZE];
+
+
+INTERNAL BrainfckStatus trap_finish(Trap* trap){
+    active_trap = NULL;
+    if(trap->status != BRAINFCK_OK) memcpy(error_message, trap->message, sizeof(error_message));
+    return trap->status;
+}
+
+
+INTERNAL BrainfckStatus library_error(BrainfckStatus status, const char* message){
+    snprintf(error_message, sizeof(error_message), "%s", message);
+    return status;
+}
+
+
+//finds the bracket errors lex_source would end the process for, so lexing can only fail on memory after it
+INTERNAL void brackets_check(Source* source){
+    uint64_t depth = 0;
+    uint32_t line = 1;
+    for(size_t i = 0; i < source->size; i++){
+        char c = source->data[i];
+        if(c == '\n') line++;
+        else if(c == '[') depth++;
+        else if(c == ']' && depth-- == 0) fatal_status(BRAINFCK_ERROR_SYNTAX, "Mismatched Brackets on Line %d\n", line);
+    }
+    if(depth != 0) fatal_status(BRAINFCK_ERROR_SYNTAX, "No Final Closing Bracket\n");
+}
+
+
+BrainfckStatus brainfck_compile(const char* source, size_t size, const BrainfckOptions* options, BrainfckProgram** program){
+    if(program == NULL || (source == NULL && size != 0)) return library_error(BRAINFCK_ERROR_ARGUMENT, "No source or program given\n");
+    *program = NULL;
+    BrainfckOptions chosen = options != NULL ? *options : (BrainfckOptions){0};
+
+    uint32_t cell_bytes;
+    switch (chosen.cell_bits) {
+        case 0:
+        case 8:
+            cell_bytes = 1;
+            break;
+        case 16:
+            cell_bytes = 2;
+            break;
+        case 32:
+            cell_bytes = 4;
+            break;
+        default:
+            return library_error(BRAINFCK_ERROR_ARGUMENT, "Unsupported cell width, expected 8, 16 or 32\n");
+    }
+
+    BrainfckProgram* result = malloc(sizeof(BrainfckProgram));
+    if(result == NULL) return library_error(BRAINFCK_ERROR_MEMORY, OUT_OF_MEM);
+    Trap trap = {0};
+    active_trap = &trap;
+    if(TRAP_SET(&trap) != 0){
+        free(result);
+        return trap_finish(&trap);
+    }
+
+    Source text = {source, size};
+    brackets_check(&text);
+    Tokens tokens = lex_source(&text);
+    Tokens optimized = optimize_tokens(&tokens, (chosen.max_tape_bytes != 0 ? chosen.max_tape_bytes : MAX_PROGRAM_SIZE) / cell_bytes);
+    tokens_delete(&tokens);
+    result->code = bytecode_create(&optimized);
+    result->cell_bytes = cell_bytes;
+    result->guard = tape_guard_size(&optimized, cell_bytes);
+    if(chosen.max_tape_bytes == 0) chosen.max_tape_bytes = tape_size_needed(&optimized, cell_bytes);
+    tokens_delete(&optimized);
+    result->options = chosen;
+
+    *program = result;
+    return trap_finish(&trap);
+}
+
+
+INTERNAL size_t discard_output(void* context, const uint8_t* data, size_t size){
+    (void)context;
+    (void)data;
+    return size;
+}
+
+
+//every run gets its own tape and io and only reads the bytecode, so runs of one program can happen on several threads at once
+BrainfckStatus brainfck_run(const BrainfckProgram* program, BrainfckIo* io){
+    if(program == NULL || io == NULL) return library_error(BRAINFCK_ERROR_ARGUMENT, "No program or io given\n");
+    io->output_size = 0;
+    Bytecode* code = (Bytecode*)&program->code;
+
+    Io run_io = {
+        .read = io->read,
+        .input_data = io->input,
+        .input_size = io->input != NULL ? io->input_size : 0,
+        .write = io->output != NULL ? NULL : io->write != NULL ? io->write : discard_output,
+        .context = io->context,
+        .limit = program->options.max_output,
+    };
+    if(io->output != NULL){
+        run_io.buffer = io->output;
+        run_io.capacity = io->output_capacity;
+        if(run_io.limit != 0 && run_io.capacity > run_io.limit) run_io.capacity = run_io.limit;
+        run_io.fixed = true;
+    } else{
+        run_io.capacity = IO_BUFFER_SIZE;
+        run_io.buffer = malloc(run_io.capacity);
+    }
+    if(run_io.buffer == NULL){
+        io_delete(&run_io);
+        return library_error(BRAINFCK_ERROR_MEMORY, OUT_OF_MEM);
+    }
+
+    Trap trap = {0};
+    active_trap = &trap;
+    Tape tape = {0};
+    if(TRAP_SET(&trap) == 0) tape = tape_create(program->options.max_tape_bytes, program->guard);
+
+    if(trap.status == BRAINFCK_OK && TRAP_SET(&trap) == 0){
+        guarded_tape = &tape;
+        uint64_t max_iterations = program->options.max_iterations != 0 ? program->options.max_iterations : UINT64_MAX;
+        switch (program->cell_bytes) {
+            case 1:
+                limited_progam_8(code, &tape, &run_io, max_iterations);
+                break;
+            case 2:
+                limited_progam_16(code, &tape, &run_io, max_iterations);
+                break;
+            case 4:
+                limited_progam_32(code, &tape, &run_io, max_iterations);
+                break;
+        }
+        io_flush(&run_io);
+    }
+    guarded_tape = NULL;
+
+    //the output up to a fault or the iteration limit still goes to the caller
+    bool output_failed = trap.status == BRAINFCK_ERROR_OUTPUT || trap.status == BRAINFCK_ERROR_OUTPUT_LIMIT;
+    if(trap.status != BRAINFCK_OK && !output_failed && run_io.size > 0){
+        Trap flush_trap = {0};
+        active_trap = &flush_trap;
+        if(TRAP_SET(&flush_trap) == 0) io_flush(&run_io);
+    }
+    io->output_size = run_io.fixed ? run_io.size : run_io.written;
+
+    if(tape.memory != NULL) tape_delete(&tape);
+    io_delete(&run_io);
+    return trap_finish(&trap);
+}
+
+
+void brainfck_free(BrainfckProgram* program){
+    if(program == NULL) return;
+    bytecode_delete(&program->code);
+    free(program);
+}
+
+
+const char* brainfck_error_message(void){
+    return error_message;
+}
+
+
+
+
+
+#if !defined(BRAINFCK_LIBRARY)
+//index of the TOK_SET_ZERO that ends the TOK_MUL_ADD group starting at index
+//backends skip the whole group when the current cell is zero so they never touch the target cells
+uint32_t mul_add_group_end(Tokens* tokens, uint32_t index){
+    while(tokens->data[index].type == TOK_MUL_ADD) index++;
+    return index;
+}
+
+
+//a '.' repeated more often than this prints from a counted loop instead of one call per byte
+#define MAX_UNROLLED_PRINTS 8
+
+
+//the amount of a '+' or '-' wrapped to the cell width, what the immediates of the encoders hold
+uint32_t cell_amount(Token tok, uint32_t cell_bytes){
+    return cell_bytes == 4 ? tok.amount : tok.amount & ((1u << 8 * cell_bytes) - 1);
+}
+
+
+//machine code buffer for the jit and the elf writer
+typedef struct {
+    uint8_t* data;
+    uint32_t capacity;
+    uint32_t size;
+} Code;
+
+
+Code code_init(){
+    Code result;
+    result.data = malloc(4096);
+    if(result.data == NULL) fatal_error(OUT_OF_MEM);
+    result.capacity = 4096;
+    result.size = 0;
+    return result;
+}
+
+
+void code_append(Code* code, const void* bytes, uint32_t size){
+    while(code->size + size > code->capacity){
+        code->capacity *= 2;
+        code->data = realloc(code->data, code->capacity);
+        if(code->data == NULL) fatal_error(OUT_OF_MEM);
+    }
+    memcpy(code->data + code->size, bytes, size);
+    code->size += size;
+}
+
+
+void code_u8(Code* code, uint8_t value){
+    code_append(code, &value, 1);
+}
+
+
+void code_u32(Code* code, uint32_t value){
+    uint8_t bytes[4] = {value, value >> 8, value >> 16, value >> 24};
+    code_append(code, bytes, 4);
+}
+
+
+void code_u64(Code* code, uint64_t value){
+    code_u32(code, value);
+    code_u32(code, value >> 32);
+}
+
+
+//points the rel32 stored at index to target
+void code_patch_rel32(Code* code, uint32_t index, uint32_t target){
+    uint32_t rel = target - (index + 4);
+    uint8_t bytes[4] = {rel, rel >> 8, rel >> 16, rel >> 24};
+    memcpy(code->data + index, bytes, 4);
+}
+
+
+void code_delete(Code* code){
+    free(code->data);
+}
+
+
+//the encoders keep the current cell in a register while the dp stays put
+//cached is set while the register holds the cell and dirty while the cell in memory is older than the register
+typedef struct {
+    bool cached;
+    bool dirty;
+} CellCache;
+
+
+#if defined(__x86_64__) && (defined(__linux__) || (defined(__APPLE__) && defined(__MACH__)))
+    //x86_64 encodings, r12 holds the cells pointer and r13 the dp like the nasm output
+    #define X64_ADD 0
+    #define X64_SUB 5
+    #define X64_CMP 7
+    #define X64_EAX 0
+    #define X64_ECX 1
+    #define X64_EDX 2
+    #define X64_EBP 5
+    #define X64_ESI 6
+    #define X64_EDI 7
+
+    //emits opcode with the memory operand [r12 + r13 + cell * cell_bytes]
+    //16 bit cells get the operand size prefix when prefix is set
+    void x64_cell_op(Code* code, uint32_t cell_bytes, bool prefix, const uint8_t* opcode, uint32_t opcode_size, uint8_t reg, int32_t cell){
+        if(prefix && cell_bytes == 2) code_u8(code, 0x66);
+        code_u8(code, 0x43); //REX.X for r13 and REX.B for r12
+        code_append(code, opcode, opcode_size);
+        code_u8(code, 0x84 | reg << 3); //mod = disp32, rm = SIB
+        code_u8(code, 0x2C); //index = r13, base = r12
+        code_u32(code, cell * cell_bytes);
+    }
+
+    //op [cell], imm with the size of the cell, opcode is the byte form (0x80 add/sub/cmp, 0xC6 mov)
+    //the wider forms are the next opcode with an imm16 or imm32
+    void x64_cell_imm(Code* code, uint32_t cell_bytes, uint8_t opcode, uint8_t op, int32_t cell, uint32_t imm){
+        uint8_t wide = opcode + 1;
+        x64_cell_op(code, cell_bytes, true, cell_bytes == 1 ? &opcode : &wide, 1, op, cell);
+        uint8_t bytes[4] = {imm, imm >> 8, imm >> 16, imm >> 24};
+        code_append(code, bytes, cell_bytes);
+    }
+
+    //op [cell], reg with the size of the cell, opcode is the byte form (0x00 add, 0x88 mov)
+    void x64_cell_reg(Code* code, uint32_t cell_bytes, uint8_t opcode, uint8_t reg, int32_t cell){
+        uint8_t wide = opcode + 1;
+        x64_cell_op(code, cell_bytes, true, cell_bytes == 1 ? &opcode : &wide, 1, reg, cell);
+    }
+
+    //zero extends the cell into reg
+    void x64_cell_load(Code* code, uint32_t cell_bytes, uint8_t reg, int32_t cell){
+        switch (cell_bytes) {
+            case 1:
+                x64_cell_op(code, cell_bytes, false, (uint8_t[]){0x0F, 0xB6}, 2, reg, cell); //movzx r32, byte
+                break;
+            case 2:
+                x64_cell_op(code, cell_bytes, false, (uint8_t[]){0x0F, 0xB7}, 2, reg, cell); //movzx r32, word
+                break;
+            default:
+                x64_cell_op(code, cell_bytes, false, (uint8_t[]){0x8B}, 1, reg, cell); //mov r32, dword
+                break;
+        }
+    }
+
+    //bpl and bp need a REX or an operand size prefix, the bits above the cell in ebp are never looked at
+    void x64_value_prefix(Code* code, uint32_t cell_bytes){
+        if(cell_bytes == 1) code_u8(code, 0x40);
+        if(cell_bytes == 2) code_u8(code, 0x66);
+    }
+
+
+    //op bpl/bp/ebp, imm with the size of the cell, op is X64_ADD or X64_SUB
+    void x64_value_imm(Code* code, uint32_t cell_bytes, uint8_t op, uint32_t imm){
+        x64_value_prefix(code, cell_bytes);
+        code_append(code, (uint8_t[]){cell_bytes == 1 ? 0x80 : 0x81, 0xC0 | op << 3 | X64_EBP}, 2);
+        uint8_t bytes[4] = {imm, imm >> 8, imm >> 16, imm >> 24};
+        code_append(code, bytes, cell_bytes);
+    }
+
+
+    //test bpl/bp/ebp with itself
+    void x64_value_test(Code* code, uint32_t cell_bytes){
+        x64_value_prefix(code, cell_bytes);
+        code_append(code, (uint8_t[]){cell_bytes == 1 ? 0x84 : 0x85, 0xED}, 2);
+    }
+
+
+    //loads the current cell into ebp unless it is already there
+    void x64_cache_load(Code* code, uint32_t cell_bytes, CellCache* cache){
+        if(cache->cached) return;
+        x64_cell_load(code, cell_bytes, X64_EBP, 0);
+        cache->cached = true;
+        cache->dirty = false;
+    }
+
+
+    //writes ebp back when the cell in memory is older
+    void x64_cache_store(Code* code, uint32_t cell_bytes, CellCache* cache){
+        if(!cache->dirty) return;
+        x64_cell_reg(code, cell_bytes, 0x88, X64_EBP, 0); //mov [cell], bpl/bp/ebp
+        cache->dirty = false;
+    }
+
+
+    //before the dp moves or the cell is written in memory
+    void x64_cache_drop(Code* code, uint32_t cell_bytes, CellCache* cache){
+        x64_cache_store(code, cell_bytes, cache);
+        cache->cached = false;
+    }
+
+
+    //lea rsi, [r12 + r13 + cell * cell_bytes], the argument of the print and input routines
+    void x64_cell_address(Code* code, uint32_t cell_bytes, int32_t cell){
+        code_append(code, (uint8_t[]){0x4B, 0x8D, 0xB4, 0x2C}, 4);
+        code_u32(code, cell * cell_bytes);
+    }
+
+    //add/sub r13, imm32, r13 counts bytes
+    void x64_move_dp(Code* code, uint8_t op, uint32_t amount){
+        code_append(code, (uint8_t[]){0x49, 0x81, 0xC5 | op << 3}, 3);
+        code_u32(code, amount);
+    }
+
+    //calls the C function at address, r12 and r13 are callee saved
+    void x64_call(Code* code, void* function){
+        code_append(code, (uint8_t[]){0x48, 0xB8}, 2); //mov rax, imm64
+        code_u64(code, (uint64_t)(uintptr_t)function);
+        code_append(code, (uint8_t[]){0xFF, 0xD0}, 2); //call rax
+    }
+
+    //jcc rel32 with the target patched in later, returns the index of the rel32
+    uint32_t x64_jcc(Code* code, uint8_t condition){
+        code_append(code, (uint8_t[]){0x0F, condition}, 2);
+        code_u32(code, 0);
+        return code->size - 4;
+    }
+    #define X64_JB 0x82
+    #define X64_JAE 0x83
+    #define X64_JE 0x84
+    #define X64_JNE 0x85
+    #define X64_JA 0x87
+    #define X64_JS 0x88
+    #define X64_JLE 0x8E
+
+    //jmp or call rel32 with the target patched in later, returns the index of the rel32
+    uint32_t x64_jump(Code* code, uint8_t opcode){
+        code_u8(code, opcode);
+        code_u32(code, 0);
+        return code->size - 4;
+    }
+    #define X64_CALL 0xE8
+    #define X64_JMP 0xE9
+
+    //mov r32, imm32 for eax to edi, zero extends into the full register
+    void x64_mov32(Code* code, uint8_t reg, uint32_t value){
+        code_u8(code, 0xB8 | reg);
+        code_u32(code, value);
+    }
+
+
+    //searches for the zero cell of a scan 16 bytes at a time with sse2, which every x86_64 cpu has
+    //stops at the zero cell or where the next block would leave the tape of tape_size bytes
+    //the scalar loop emitted after it finishes the scan from there
+    void x64_scan_blocks(Code* code, bool right, uint32_t byte_stride, uint32_t cell_bytes, uint64_t tape_size){
+        uint32_t lane_count = scan_lane_count(16, byte_stride, cell_bytes);
+        code_append(code, (uint8_t[]){0x66, 0x0F, 0xEF, 0xC9}, 4); //pxor xmm1, xmm1
+        if(right){
+            code_append(code, (uint8_t[]){0x48, 0xBA}, 2); //mov rdx, imm64
+            code_u64(code, tape_size - 16);
+        }
+
+        uint32_t block = code->size;
+        uint32_t outside;
+        if(right){
+            code_append(code, (uint8_t[]){0x49, 0x39, 0xD5}, 3); //cmp r13, rdx
+            outside = x64_jcc(code, X64_JA);
+        } else{
+            code_append(code, (uint8_t[]){0x49, 0x81, 0xFD}, 3); //cmp r13, imm32
+            code_u32(code, 16 - cell_bytes);
+            outside = x64_jcc(code, X64_JB);
+        }
+        //movdqu xmm0, [r12 + r13 + disp32], left scans load the block ending with the current cell
+        code_append(code, (uint8_t[]){0xF3, 0x43, 0x0F, 0x6F, 0x84, 0x2C}, 6);
+        code_u32(code, right ? 0 : -(int32_t)(16 - cell_bytes));
+        code_append(code, (uint8_t[]){0x66, 0x0F, 0x74, 0xC1}, 4); //pcmpeqb xmm0, xmm1
+        code_append(code, (uint8_t[]){0x66, 0x0F, 0xD7, 0xC0}, 4); //pmovmskb eax, xmm0
+        //a cell is zero when all of its bytes are
+        if(cell_bytes >= 2) code_append(code, (uint8_t[]){0x89, 0xC1, 0xD1, 0xE9, 0x21, 0xC8}, 6); //mov ecx, eax, shr ecx, 1, and eax, ecx
+        if(cell_bytes == 4) code_append(code, (uint8_t[]){0x89, 0xC1, 0xC1, 0xE9, 0x02, 0x21, 0xC8}, 7); //mov ecx, eax, shr ecx, 2, and eax, ecx
+        code_u8(code, 0x25); //and eax, imm32
+        code_u32(code, scan_lanes(16, 1, byte_stride, cell_bytes, !right));
+        uint32_t found = x64_jcc(code, X64_JNE);
+        x64_move_dp(code, right ? X64_ADD : X64_SUB, lane_count * byte_stride);
+        code_patch_rel32(code, x64_jump(code, X64_JMP), block);
+
+        //the zero cell is the lowest lane for right scans and the highest for left scans
+        code_patch_rel32(code, found, code->size);
+        code_append(code, (uint8_t[]){0x0F, right ? 0xBC : 0xBD, 0xC0}, 3); //bsf/bsr eax, eax
+        code_append(code, (uint8_t[]){0x49, 0x01, 0xC5}, 3); //add r13, rax
+        if(!right) x64_move_dp(code, X64_SUB, 16 - cell_bytes);
+        code_patch_rel32(code, outside, code->size);
+    }
+
+
+    //encodes the tokens operating on cells of cell_bytes, shared by the jit and the elf writer
+    //print and input are the offsets of routines that take the address of the cell in rsi
+    //the current cell lives in ebp from the first loop test or arithmetic on it until the dp moves, see CellCache
+    //at the loop brackets it is in ebp and stored, so both paths into a loop agree
+    //with counts every token adds one to its count when it runs, rax and the flags are free between tokens
+    //returns the offset of the code of token resume, a progam continuing from a Prerun jumps there with nothing in ebp
+    uint32_t x64_encode_tokens(Code* code, Tokens* tokens, uint32_t cell_bytes, uint64_t tape_size, uint32_t print, uint32_t input, uint32_t resume, uint64_t* counts){
+        Stack bracket_stack = {0};
+        uint32_t mul_add_skip = 0;
+        uint32_t resume_offset = code->size;
+        CellCache cache = {0};
+
+        for(uint32_t i = 0; i < tokens->size; i++){
+            Token tok = tokens->data[i];
+            if(i == resume){
+                x64_cache_drop(code, cell_bytes, &cache);
+                resume_offset = code->size;
+            }
+            if(counts != NULL && !stats_follows_group(tokens, i)){
+                code_append(code, (uint8_t[]){0x48, 0xB8}, 2); //mov rax, imm64
+                code_u64(code, (uint64_t)(uintptr_t)&counts[i]);
+                code_append(code, (uint8_t[]){0x48, 0xFF, 0x00}, 3); //inc qword [rax]
+            }
+            switch (tok.type) {
+                case '>':
+                    x64_cache_drop(code, cell_bytes, &cache);
+                    x64_move_dp(code, X64_ADD, tok.amount * cell_bytes);
+                    break;
+                case '<':
+                    x64_cache_drop(code, cell_bytes, &cache);
+                    x64_move_dp(code, X64_SUB, tok.amount * cell_bytes);
+                    break;
+                case '+':
+                case '-':
+                    {
+                    uint8_t op = tok.type == '+' ? X64_ADD : X64_SUB;
+                    //loading the cell for a single add costs more than adding to memory
+                    if(tok.cell != 0 || !cache.cached){
+                        x64_cell_imm(code, cell_bytes, 0x80, op, tok.cell, tok.amount);
+                        break;
+                    }
+                    x64_value_imm(code, cell_bytes, op, tok.amount);
+                    cache.dirty = true;
+                    break;
+                    }
+                case '.':
+                    {
+                    if(tok.cell == 0) x64_cache_store(code, cell_bytes, &cache);
+                    if(tok.amount <= MAX_UNROLLED_PRINTS){
+                        for(uint32_t j = 0; j < tok.amount; j++){
+                            x64_cell_address(code, cell_bytes, tok.cell);
+                            code_patch_rel32(code, x64_jump(code, X64_CALL), print);
+                        }
+                        break;
+                    }
+                    //every register is taken, the count goes on the stack in a slot that keeps it aligned for calls
+                    code_append(code, (uint8_t[]){0x48, 0x83, 0xEC, 0x10, 0xC7, 0x04, 0x24}, 7); //sub rsp, 16, mov dword [rsp], imm32
+                    code_u32(code, tok.amount);
+                    uint32_t loop = code->size;
+                    x64_cell_address(code, cell_bytes, tok.cell);
+                    code_patch_rel32(code, x64_jump(code, X64_CALL), print);
+                    code_append(code, (uint8_t[]){0xFF, 0x0C, 0x24}, 3); //dec dword [rsp]
+                    code_patch_rel32(code, x64_jcc(code, X64_JNE), loop);
+                    code_append(code, (uint8_t[]){0x48, 0x83, 0xC4, 0x10}, 4); //add rsp, 16
+                    break;
+                    }
+                case ',':
+                    if(tok.cell == 0) x64_cache_drop(code, cell_bytes, &cache);
+                    x64_cell_address(code, cell_bytes, tok.cell);
+                    code_patch_rel32(code, x64_jump(code, X64_CALL), input);
+                    break;
+                case '[':
+                    x64_cache_load(code, cell_bytes, &cache);
+                    x64_cache_store(code, cell_bytes, &cache);
+                    x64_value_test(code, cell_bytes);
+                    stack_push(&bracket_stack, x64_jcc(code, X64_JE));
+                    break;
+                case ']':
+                    {
+                    uint32_t opening = stack_pop(&bracket_stack);
+                    x64_cache_load(code, cell_bytes, &cache);
+                    x64_cache_store(code, cell_bytes, &cache);
+                    x64_value_test(code, cell_bytes);
+                    code_patch_rel32(code, x64_jcc(code, X64_JNE), opening + 4);
+                    code_patch_rel32(code, opening, code->size);
+                    break;
+                    }
+                case TOK_SET_ZERO:
+                    if(tok.cell == 0){
+                        code_append(code, (uint8_t[]){0x31, 0xED}, 2); //xor ebp, ebp
+                        cache.cached = true;
+                        cache.dirty = true;
+                    } else{
+                        x64_cell_imm(code, cell_bytes, 0xC6, 0, tok.cell, 0); //mov [cell], 0
+                    }
+                    if(i > 0 && tokens->data[i - 1].type == TOK_MUL_ADD) code_patch_rel32(code, mul_add_skip, code->size);
+                    break;
+                case TOK_MUL_ADD:
+                    {
+                    //a group on another cell may add into the current one, which then has to be in memory on both paths
+                    bool first = i == 0 || tokens->data[i - 1].type != TOK_MUL_ADD;
+                    if(first && tok.cell != 0) x64_cache_drop(code, cell_bytes, &cache);
+                    uint8_t source = X64_EAX;
+                    if(tok.cell == 0){
+                        x64_cache_load(code, cell_bytes, &cache);
+                        if(first) x64_value_test(code, cell_bytes);
+                        source = X64_EBP;
+                    } else{
+                        if(first) x64_cell_imm(code, cell_bytes, 0x80, X64_CMP, tok.cell, 0);
+                        x64_cell_load(code, cell_bytes, X64_EAX, tok.cell);
+                    }
+                    if(first) mul_add_skip = x64_jcc(code, X64_JE);
+                    //the low bits of the product only depend on the low bits of the cell
+                    code_append(code, (uint8_t[]){0x69, 0xC0 | source}, 2); //imul eax, eax/ebp, imm32
+                    code_u32(code, (int8_t)tok.amount);
+                    x64_cell_reg(code, cell_bytes, 0x00, X64_EAX, tok.target); //add [target], eax
+                    break;
+                    }
+                case TOK_SCAN_RIGHT:
+                case TOK_SCAN_LEFT:
+                    {
+                    x64_cache_store(code, cell_bytes, &cache);
+                    uint8_t op = tok.type == TOK_SCAN_RIGHT ? X64_ADD : X64_SUB;
+                    uint32_t byte_stride = tok.amount * cell_bytes;
+                    uint32_t skip = 0;
+                    if(scan_lane_count(16, byte_stride, cell_bytes) >= SCAN_MIN_LANES){
+                        x64_cell_imm(code, cell_bytes, 0x80, X64_CMP, 0, 0);
+                        skip = x64_jcc(code, X64_JE);
+                        x64_scan_blocks(code, tok.type == TOK_SCAN_RIGHT, byte_stride, cell_bytes, tape_size);
+                    }
+
+                    //one cell at a time, also checks the cell the blocks stopped at
+                    code_append(code, (uint8_t[]){0xEB, 0x07}, 2); //jmp over the 7 byte move to the test
+                    uint32_t loop = code->size;
+                    x64_move_dp(code, op, byte_stride);
+                    x64_cell_imm(code, cell_bytes, 0x80, X64_CMP, 0, 0);
+                    code_patch_rel32(code, x64_jcc(code, X64_JNE), loop);
+                    if(skip != 0) code_patch_rel32(code, skip, code->size);
+                    //a scan always stops at a zero cell
+                    code_append(code, (uint8_t[]){0x31, 0xED}, 2); //xor ebp, ebp
+                    cache.cached = true;
+                    cache.dirty = false;
+                    break;
+                    }
+                default:
+                    break;
+            }
+        }
+        if(resume == tokens->size) resume_offset = code->size;
+        stack_delete(&bracket_stack);
+        return resume_offset;
+    }
+
+
+    //print and input routines for the jit that take the address of the cell in rsi and go through io
+    //returns the offset of print, input is right behind it
+    uint32_t x64_io_routines(Code* code, Io* io, uint32_t cell_bytes, uint32_t* input){
+        //movzx esi, byte [rsi] and tail call io_write(io, esi)
+        uint32_t print = code->size;
+        code_append(code, (uint8_t[]){0x0F, 0xB6, 0x36}, 3);
+        code_append(code, (uint8_t[]){0x48, 0xBF}, 2); //mov rdi, imm64
+        code_u64(code, (uint64_t)(uintptr_t)io);
+        code_append(code, (uint8_t[]){0x48, 0xB8}, 2); //mov rax, imm64
+        code_u64(code, (uint64_t)(uintptr_t)io_write);
+        code_append(code, (uint8_t[]){0xFF, 0xE0}, 2); //jmp rax
+
+        //rsi is caller saved, keep it across the call and store the result in the cell
+        *input = code->size;
+        code_u8(code, 0x56); //push rsi
+        code_append(code, (uint8_t[]){0x48, 0xBF}, 2); //mov rdi, imm64
+        code_u64(code, (uint64_t)(uintptr_t)io);
+        x64_call(code, io_read);
+        code_u8(code, 0x5E); //pop rsi
+        if(cell_bytes == 2) code_u8(code, 0x66);
+        code_append(code, (uint8_t[]){cell_bytes == 1 ? 0x88 : 0x89, 0x06, 0xC3}, 3); //mov [rsi], al/ax/eax, ret
+        return print;
+    }
+
+
+    //encodes the tokens into a function void(int8_t* cells) and returns its offset
+    //the print and input routines in front of it go through io, counts is NULL or gets the executions of every token
+    uint32_t jit_encode(Code* code, Tokens* tokens, uint32_t cell_bytes, uint64_t tape_size, Io* io, uint64_t* counts){
+        uint32_t input;
+        uint32_t print = x64_io_routines(code, io, cell_bytes, &input);
+
+        uint32_t entry = code->size;
+        //push rbp (the current cell, also keeps the stack 16 byte aligned for calls), push r12, push r13
+        code_append(code, (uint8_t[]){0x55, 0x41, 0x54, 0x41, 0x55}, 5);
+        //mov r12, rdi / xor r13d, r13d
+        code_append(code, (uint8_t[]){0x49, 0x89, 0xFC, 0x45, 0x31, 0xED}, 6);
+
+        x64_encode_tokens(code, tokens, cell_bytes, tape_size, print, input, 0, counts);
+
+        //pop r13, pop r12, pop rbp, ret
+        code_append(code, (uint8_t[]){0x41, 0x5D, 0x41, 0x5C, 0x5D, 0xC3}, 6);
+        return entry;
+    }
+
+
+    //encodes the program into memory and runs it on tape without an assembler or linker
+    //the buffer is only ever writable or executable, never both
+    void jit_run(Tokens* tokens, uint32_t cell_bytes, Tape* tape, Io* io, uint64_t* counts){
+        Code code = code_init();
+        uint32_t entry = jit_encode(&code, tokens, cell_bytes, tape->size, io, counts);
+
+        uint8_t* memory = mmap(NULL, code.size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if(memory == MAP_FAILED) fatal_error(OUT_OF_MEM);
+        memcpy(memory, code.data, code.size);
+        if(mprotect(memory, code.size, PROT_READ | PROT_EXEC) != 0) fatal_error("Failed to make jit code executable\n");
+
+        void (*function)(int8_t*) = (void (*)(int8_t*))(memory + entry);
+        function(tape->cells);
+
+        munmap(memory, code.size);
+        code_delete(&code);
+    }
+
+
+    void jit_progam(Tokens* tokens, uint32_t cell_bytes){
+        Tape tape = tape_create(tape_size_needed(tokens, cell_bytes), tape_guard_size(tokens, cell_bytes));
+        Io io = io_create(stdin, stdout);
+        guarded_tape = &tape;
+        guarded_io = &io;
+
+        jit_run(tokens, cell_bytes, &tape, &io, NULL);
+        io_flush(&io);
+
+        guarded_tape = NULL;
+        guarded_io = NULL;
+        io_delete(&io);
+        tape_delete(&tape);
+    }
+
+
+    //compiles the loop whose ']' is at offset jump of the bytecode into a NativeLoop
+    //and writes OP_NATIVE over its '[', so the interpreter calls the native loop from then on
+    //returns the index of the loop in tier->loops
+    uint32_t tier_compile(Tier* tier, uint32_t jump){
+        Bytecode* code = tier->code;
+        Tokens* tokens = tier->tokens;
+        //the ']' is the last token at its offset, only the MUL_ADD after the first of a group take no bytecode
+        uint32_t low = 0;
+        uint32_t high = tokens->size;
+        while(low < high){
+            uint32_t middle = low + (high - low) / 2;
+            if(code->offsets[middle] <= jump) low = middle + 1;
+            else high = middle;
+        }
+        uint32_t close = low - 1;
+        uint32_t open = tokens->data[close].offset;
+        Tokens loop = {tokens->data + open, close - open + 1, close - open + 1};
+
+        //print and input go through the io of the interpreter, so the output stays in order
+        Code native = code_init();
+        uint32_t input;
+        uint32_t print = x64_io_routines(&native, tier->io, tier->cell_bytes, &input);
+
+        uint32_t entry = native.size;
+        //push rbp, push r12, push r13 / mov r12, rdi / mov r13, rsi
+        code_append(&native, (uint8_t[]){0x55, 0x41, 0x54, 0x41, 0x55}, 5);
+        code_append(&native, (uint8_t[]){0x49, 0x89, 0xFC, 0x49, 0x89, 0xF5}, 6);
+        x64_encode_tokens(&native, &loop, tier->cell_bytes, tier->tape_size, print, input, 0, NULL);
+        //mov rax, r13 / pop r13, pop r12, pop rbp, ret
+        code_append(&native, (uint8_t[]){0x4C, 0x89, 0xE8}, 3);
+        code_append(&native, (uint8_t[]){0x41, 0x5D, 0x41, 0x5C, 0x5D, 0xC3}, 6);
+
+        uint8_t* memory = mmap(NULL, native.size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if(memory == MAP_FAILED) fatal_error(OUT_OF_MEM);
+        memcpy(memory, native.data, native.size);
+        if(mprotect(memory, native.size, PROT_READ | PROT_EXEC) != 0) fatal_error("Failed to make jit code executable\n");
+
+        if(tier->loop_count == tier->loop_capacity){
+            tier->loop_capacity = tier->loop_capacity == 0 ? 16 : tier->loop_capacity * 2;
+            tier->loops = realloc(tier->loops, tier->loop_capacity * sizeof(TierLoop));
+            if(tier->loops == NULL) fatal_error(OUT_OF_MEM);
+        }
+        tier->loops[tier->loop_count] = (TierLoop){memory, native.size, (NativeLoop)(memory + entry)};
+        code_delete(&native);
+
+        uint32_t head = code->offsets[open];
+        code->data[head] = code->data[head] == OP_JMP_ZERO ? OP_NATIVE : OP_NATIVE_WIDE;
+        tier->heat[head] = tier->loop_count;
+        return tier->loop_count++;
+    }
+
+
+    //interprets the progam and compiles its hot loops on the way
+    void tiered_progam(Tokens* tokens, uint32_t cell_bytes){
+        Tape tape = tape_create(tape_size_needed(tokens, cell_bytes), tape_guard_size(tokens, cell_bytes));
+        Io io = io_create(stdin, stdout);
+        Bytecode code = bytecode_create(tokens);
+        Tier tier = {.tokens = tokens, .code = &code, .io = &io, .tape_size = tape.size, .cell_bytes = cell_bytes};
+        tier.heat = calloc(code.size, sizeof(uint32_t));
+        if(tier.heat == NULL) fatal_error(OUT_OF_MEM);
+        guarded_tape = &tape;
+        guarded_io = &io;
+
+        switch (cell_bytes) {
+            case 1:
+                tiered_progam_8(&code, &tape, &io, &tier);
+                break;
+            case 2:
+                tiered_progam_16(&code, &tape, &io, &tier);
+                break;
+            case 4:
+                tiered_progam_32(&code, &tape, &io, &tier);
+                break;
+        }
+        io_flush(&io);
+
+        guarded_tape = NULL;
+        guarded_io = NULL;
+        for(uint32_t i = 0; i < tier.loop_count; i++) munmap(tier.loops[i].memory, tier.loops[i].size);
+        free(tier.loops);
+        free(tier.heat);
+        bytecode_delete(&code);
+        io_delete(&io);
+        tape_delete(&tape);
+    }
+#else
+    void jit_progam(Tokens* tokens, uint32_t cell_bytes){
+        (void)tokens;
+        (void)cell_bytes;
+        fatal_error("The jit is not supported for this platform\n");
+    }
+
+
+    void tiered_progam(Tokens* tokens, uint32_t cell_bytes){
+        warning("--tiered needs the jit, which is not supported for this platform, the progam is only interpreted\n");
+        interpret_progam(tokens, cell_bytes, NULL);
+    }
+#endif
+
+
+//--stats runs the progam on the counting interpreter, or the jit with a counter in front of every token
+//and writes what it did as a single json object to stderr once it finishes
+//hardware counters are read with perf_event_open on linux, one that can't be opened is null
+#define STATS_COUNTERS 4
+
+typedef struct {
+    int fds[STATS_COUNTERS];
+    bool valid[STATS_COUNTERS];
+    uint64_t values[STATS_COUNTERS];
+} StatsCounters;
+
+
+//cycles, instructions, branch misses and cache misses of this thread outside the kernel
+void stats_counters_start(StatsCounters* counters){
+    for(uint32_t i = 0; i < STATS_COUNTERS; i++){
+        counters->fds[i] = -1;
+        counters->valid[i] = false;
+        counters->values[i] = 0;
+    }
+#if defined(__linux__)
+    static const uint64_t configs[STATS_COUNTERS] = {
+        PERF_COUNT_HW_CPU_CYCLES, PERF_COUNT_HW_INSTRUCTIONS, PERF_COUNT_HW_BRANCH_MISSES, PERF_COUNT_HW_CACHE_MISSES
+    };
+    for(uint32_t i = 0; i < STATS_COUNTERS; i++){
+        struct perf_event_attr attr = {0};
+        attr.type = PERF_TYPE_HARDWARE;
+        attr.size = sizeof(attr);
+        attr.config = configs[i];
+        attr.disabled = 1;
+        attr.exclude_kernel = 1;
+        attr.exclude_hv = 1;
+        counters->fds[i] = syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0);
+    }
+    for(uint32_t i = 0; i < STATS_COUNTERS; i++){
+        if(counters->fds[i] >= 0) ioctl(counters->fds[i], PERF_EVENT_IOC_ENABLE, 0);
+    }
+#endif
+}
+
+
+void stats_counters_stop(StatsCounters* counters){
+#if defined(__linux__)
+    for(uint32_t i = 0; i < STATS_COUNTERS; i++){
+        if(counters->fds[i] >= 0) ioctl(counters->fds[i], PERF_EVENT_IOC_DISABLE, 0);
+    }
+    for(uint32_t i = 0; i < STATS_COUNTERS; i++){
+        if(counters->fds[i] < 0) continue;
+        counters->valid[i] = read(counters->fds[i], &counters->values[i], sizeof(uint64_t)) == sizeof(uint64_t);
+        close(counters->fds[i]);
+    }
+#endif
+}
+
+
+double stats_seconds(){
+#if defined(_WIN32)
+    LARGE_INTEGER count, frequency;
+    QueryPerformanceCounter(&count);
+    QueryPerformanceFrequency(&frequency);
+    return (double)count.QuadPart / frequency.QuadPart;
+#else
+    struct timespec time;
+    clock_gettime(CLOCK_MONOTONIC, &time);
+    return time.tv_sec + time.tv_nsec / 1e9;
+#endif
+}
+
+
+uint64_t stats_page_size(){
+#if defined(_WIN32)
+    SYSTEM_INFO info;
+    GetSystemInfo(&info);
+    return info.dwPageSize;
+#else
+    return sysconf(_SC_PAGESIZE);
+#endif
+}
+
+
+//counts the pages of the tape that are backed by memory, only the ones the progam touched are
+//highest gets the end of the last of them in bytes from the start of the tape
+uint64_t stats_tape_pages(Tape* tape, uint64_t page_size, uint64_t* highest){
+    uint64_t touched = 0;
+    *highest = 0;
+#if defined(_WIN32)
+    //the fault handler commits the pages one at a time
+    uint8_t* cells = (uint8_t*)tape->cells;
+    uint8_t* address = cells;
+    while(address < cells + tape->size){
+        MEMORY_BASIC_INFORMATION info;
+        if(VirtualQuery(address, &info, sizeof(info)) == 0) break;
+        uint8_t* end = (uint8_t*)info.BaseAddress + info.RegionSize;
+        if(end > cells + tape->size) end = cells + tape->size;
+        if(info.State == MEM_COMMIT){
+            touched += (end - address) / page_size;
+            *highest = end - cells;
+        }
+        address = end;
+    }
+#else
+    uint64_t pages = tape->size / page_size;
+    #if defined(__APPLE__)
+        char* resident = malloc(pages);
+    #else
+        unsigned char* resident = malloc(pages);
+    #endif
+    if(resident == NULL) fatal_error(OUT_OF_MEM);
+    if(mincore(tape->cells, tape->size, resident) == 0){
+        for(uint64_t i = 0; i < pages; i++){
+            if((resident[i] & 1) == 0) continue;
+            touched++;
+            *highest = (i + 1) * page_size;
+        }
+    }
+    free(resident);
+#endif
+    return touched;
+}
+
+
+void stats_report(Tokens* tokens, uint64_t* counts, const char* mode, uint32_t cell_bytes, double seconds, Io* io,
+                  uint64_t pages, uint64_t page_size, uint64_t peak, StatsCounters* counters){
+    static const struct {
+        uint8_t type;
+        const char* name;
+    } names[] = {
+        {'>', "move_right"}, {'<', "move_left"}, {'+', "add"}, {'-', "sub"}, {'.', "output"}, {',', "input"},
+        {'[', "loop_start"}, {']', "loop_end"}, {TOK_SET_ZERO, "set_zero"}, {TOK_MUL_ADD, "mul_add"},
+        {TOK_SCAN_RIGHT, "scan_right"}, {TOK_SCAN_LEFT, "scan_left"}
+    };
+    static const char* counter_names[STATS_COUNTERS] = {"cycles", "instructions", "branch_misses", "cache_misses"};
+    uint64_t by_type[TOK_INVALID + 1] = {0};
+    uint64_t executed = 0;
+    for(uint32_t i = 0; i < tokens->size; i++){
+        by_type[tokens->data[i].type] += counts[i];
+        executed += counts[i];
+    }
+
+    fprintf(stderr, "{\"mode\": \"%s\", \"cell_bits\": %u, \"seconds\": %.6f, \"ops_executed\": %" PRIu64 ", \"ops\": {",
+            mode, cell_bytes * 8, seconds, executed);
+    for(uint32_t i = 0; i < sizeof(names) / sizeof(names[0]); i++){
+        fprintf(stderr, "%s\"%s\": %" PRIu64, i == 0 ? "" : ", ", names[i].name, by_type[names[i].type]);
+    }
+    //the body of a loop ran once for every time its ']' was reached
+    fprintf(stderr, "}, \"loop_iterations\": %" PRIu64 ", \"bytes_read\": %" PRIu64 ", \"bytes_written\": %" PRIu64,
+            by_type[']'], io->consumed, io->written);
+    fprintf(stderr, ", \"tape_pages_touched\": %" PRIu64 ", \"page_size\": %" PRIu64 ", \"peak_tape_bytes\": %" PRIu64, pages, page_size, peak);
+    for(uint32_t i = 0; i < STATS_COUNTERS; i++){
+        if(counters->valid[i]) fprintf(stderr, ", \"%s\": %" PRIu64, counter_names[i], counters->values[i]);
+        else fprintf(stderr, ", \"%s\": null", counter_names[i]);
+    }
+    fprintf(stderr, "}\n");
+}
+
+
+//runs the progam on the counting interpreter, or the jit when jit is set, and reports its stats
+void stats_progam(Tokens* tokens, uint32_t cell_bytes, bool jit){
+    Tape tape = tape_create(tape_size_needed(tokens, cell_bytes), tape_guard_size(tokens, cell_bytes));
+#if defined(MADV_NOHUGEPAGE)
+    //a huge page would count as hundreds of touched pages
+    madvise(tape.cells, tape.size, MADV_NOHUGEPAGE);
+#endif
+    Io io = io_create(stdin, stdout);
+    uint64_t* counts = calloc((size_t)tokens->size + 1, sizeof(uint64_t));
+    if(counts == NULL) fatal_error(OUT_OF_MEM);
+    Bytecode code = {0};
+    Profile profile = {0};
+    if(!jit){
+        code = bytecode_create(tokens);
+        profile.counts = calloc(code.size, sizeof(uint64_t));
+        if(profile.counts == NULL) fatal_error(OUT_OF_MEM);
+    }
+    guarded_tape = &tape;
+    guarded_io = &io;
+
+    StatsCounters counters;
+    stats_counters_start(&counters);
+    double start = stats_seconds();
+    if(jit){
+#if defined(TIERED_JIT)
+        jit_run(tokens, cell_bytes, &tape, &io, counts);
+#else
+        fatal_error("The jit is not supported for this platform\n");
+#endif
+    } else{
+        switch (cell_bytes) {
+            case 1:
+                profile_progam_8(&code, &tape, &io, &profile);
+                break;
+            case 2:
+                profile_progam_16(&code, &tape, &io, &profile);
+                break;
+            case 4:
+                profile_progam_32(&code, &tape, &io, &profile);
+                break;
+        }
+    }
+    io_flush(&io);
+    double seconds = stats_seconds() - start;
+    stats_counters_stop(&counters);
+    fflush(stdout);
+
+    guarded_tape = NULL;
+    guarded_io = NULL;
+
+    uint64_t page_size = stats_page_size();
+    uint64_t highest;
+    uint64_t pages = stats_tape_pages(&tape, page_size, &highest);
+    //the interpreter knows the highest cell, the jit only the highest page
+    uint64_t peak = highest;
+    if(!jit){
+        for(uint32_t i = 0; i < tokens->size; i++) counts[i] = profile.counts[code.offsets[i]];
+        peak = (profile.high_water + 1) * cell_bytes;
+    }
+    for(uint32_t i = 0; i < tokens->size; i++){
+        if(stats_follows_group(tokens, i)) counts[i] = counts[i - 1];
+    }
+    stats_report(tokens, counts, jit ? "jit" : "interpreter", cell_bytes, seconds, &io, pages, page_size, peak, &counters);
+
+    if(!jit){
+        free(profile.counts);
+        bytecode_delete(&code);
+    }
+    free(counts);
+    io_delete(&io);
+    tape_delete(&tape);
+}
+
+
+#if defined(__linux__) && (defined(__x86_64__) || defined(__aarch64__))
+    //-o writes a static executable directly, the text assembly is only written with --emit-asm
+    #define ELF_WRITER
+
+    //the text segment holds the headers, the error messages and the code
+    //out_buf and in_buf live in a segment that is only reserved, at a fixed address below the text
+    #define ELF_TEXT_ADDRESS 0x400000
+    #define ELF_BSS_ADDRESS 0x200000
+    #define ELF_SEGMENT_ALIGNMENT 0x10000
+    #define ELF_SEGMENTS 3
+    #define ELF_HEADERS_SIZE (sizeof(Elf64_Ehdr) + ELF_SEGMENTS * sizeof(Elf64_Phdr))
+    #define ELF_OUT_BUF ELF_BSS_ADDRESS
+    #define ELF_IN_BUF (ELF_BSS_ADDRESS + IO_BUFFER_SIZE)
+
+
+    //address the code at offset is loaded at
+    uint64_t elf_address(uint32_t offset){
+        return ELF_TEXT_ADDRESS + ELF_HEADERS_SIZE + offset;
+    }
+
+
+    //error messages and the struct sigaction of the runtime, stored in front of the code
+    typedef struct {
+        uint64_t memory;
+        uint32_t memory_size;
+        uint64_t underflow;
+        uint32_t underflow_size;
+        uint64_t overflow;
+        uint32_t overflow_size;
+        uint32_t segv_action; // offset of the struct sigaction, filled in once the handler is encoded
+    } ElfData;
+
+
+    ElfData elf_encode_data(Code* code, uint32_t size){
+        ElfData data;
+        const char* memory_msg = "Error: Out of Memory\n";
+        const char* underflow_msg = "Error: Data pointer underflow\n";
+        char overflow_msg[64];
+        snprintf(overflow_msg, sizeof(overflow_msg), "Error: Max Memory %u bytes Exceeded\n", size);
+
+        data.memory = elf_address(code->size);
+        data.memory_size = strlen(memory_msg);
+        code_append(code, memory_msg, data.memory_size);
+        data.underflow = elf_address(code->size);
+        data.underflow_size = strlen(underflow_msg);
+        code_append(code, underflow_msg, data.underflow_size);
+        data.overflow = elf_address(code->size);
+        data.overflow_size = strlen(overflow_msg);
+        code_append(code, overflow_msg, data.overflow_size);
+
+        //handler, flags, restorer and mask
+        while(code->size % 8 != 0) code_u8(code, 0);
+        data.segv_action = code->size;
+        for(int i = 0; i < 4; i++) code_u64(code, 0);
+        return data;
+    }
+
+
+    void elf_patch_sigaction(Code* code, ElfData* data, uint64_t handler, uint64_t flags, uint64_t restorer){
+        uint64_t action[3] = {handler, flags, restorer};
+        memcpy(code->data + data->segv_action, action, sizeof(action));
+    }
+
+
+    //writes the code as a static executable starting at entry
+    void elf_write(const char* output_file, Code* code, uint64_t entry, uint16_t machine){
+        Elf64_Ehdr header = {0};
+        memcpy(header.e_ident, ELFMAG, SELFMAG);
+        header.e_ident[EI_CLASS] = ELFCLASS64;
+        header.e_ident[EI_DATA] = ELFDATA2LSB;
+        header.e_ident[EI_VERSION] = EV_CURRENT;
+        header.e_ident[EI_OSABI] = ELFOSABI_SYSV;
+        header.e_type = ET_EXEC;
+        header.e_machine = machine;
+        header.e_version = EV_CURRENT;
+        header.e_entry = entry;
+        header.e_phoff = sizeof(Elf64_Ehdr);
+        header.e_ehsize = sizeof(Elf64_Ehdr);
+        header.e_phentsize = sizeof(Elf64_Phdr);
+        header.e_phnum = ELF_SEGMENTS;
+
+        Elf64_Phdr segments[ELF_SEGMENTS] = {0};
+        segments[0].p_type = PT_LOAD;
+        segments[0].p_flags = PF_R | PF_X;
+        segments[0].p_vaddr = ELF_TEXT_ADDRESS;
+        segments[0].p_paddr = ELF_TEXT_ADDRESS;
+        segments[0].p_filesz = ELF_HEADERS_SIZE + code->size;
+        segments[0].p_memsz = ELF_HEADERS_SIZE + code->size;
+        segments[0].p_align = ELF_SEGMENT_ALIGNMENT;
+
+        segments[1].p_type = PT_LOAD;
+        segments[1].p_flags = PF_R | PF_W;
+        segments[1].p_vaddr = ELF_BSS_ADDRESS;
+        segments[1].p_paddr = ELF_BSS_ADDRESS;
+        segments[1].p_memsz = 2 * IO_BUFFER_SIZE;
+        segments[1].p_align = ELF_SEGMENT_ALIGNMENT;
+
+        segments[2].p_type = PT_GNU_STACK;
+        segments[2].p_flags = PF_R | PF_W;
+
+        FILE* stream = fopen(output_file, "wb");
+        if(stream == NULL) fatal_error("Failed to create: %s (%s)\n", output_file, strerror(errno));
+        fwrite(&header, sizeof(header), 1, stream);
+        fwrite(segments, sizeof(segments), 1, stream);
+        fwrite(code->data, 1, code->size, stream);
+        if(fclose(stream) != 0) fatal_error("Failed to write: %s (%s)\n", output_file, strerror(errno));
+        if(chmod(output_file, 0755) != 0) fatal_error("Failed to make %s executable (%s)\n", output_file, strerror(errno));
+    }
+
+
+    #if defined(__x86_64__)
+        #define ELF_MACHINE EM_X86_64
+
+        void x64_syscall(Code* code){
+            code_append(code, (uint8_t[]){0x0F, 0x05}, 2);
+        }
+
+
+        void x64_test_rax(Code* code){
+            code_append(code, (uint8_t[]){0x48, 0x85, 0xC0}, 3);
+        }
+
+
+        //encodes the runtime and the program the same way the nasm output does and returns the entry point
+        //r14 bytes waiting in out_buf, r15 read position in in_buf, rbx bytes in in_buf, rbp the current cell
+        uint32_t elf_encode(Code* code, uint32_t size, uint32_t cell_bytes, Tokens* tokens, Prerun* prerun){
+            ElfData data = elf_encode_data(code, size);
+
+            //the output and the tape image of a prerun are stored in front of the code like the messages
+            uint32_t prerun_output = code->size;
+            if(prerun != NULL && prerun->output_size > 0) code_append(code, prerun->output, prerun->output_size);
+            uint32_t prerun_tape = code->size;
+            if(prerun != NULL && prerun->tape_cells > 0) code_append(code, prerun->tape, prerun->tape_cells * cell_bytes);
+
+            //print buffers the byte at rsi and flushes once out_buf is full
+            uint32_t print = code->size;
+            code_append(code, (uint8_t[]){0x8A, 0x06}, 2); //mov al, [rsi]
+            code_append(code, (uint8_t[]){0x41, 0x88, 0x86}, 3); //mov [r14 + out_buf], al
+            code_u32(code, ELF_OUT_BUF);
+            code_append(code, (uint8_t[]){0x49, 0xFF, 0xC6}, 3); //inc r14
+            code_append(code, (uint8_t[]){0x49, 0x81, 0xFE}, 3); //cmp r14, imm32
+            code_u32(code, IO_BUFFER_SIZE);
+            uint32_t print_full = x64_jcc(code, X64_JE);
+            code_u8(code, 0xC3); //ret
+
+            //flush writes out_buf until everything is written or write fails
+            uint32_t flush = code->size;
+            code_patch_rel32(code, print_full, flush);
+            x64_mov32(code, X64_ESI, ELF_OUT_BUF);
+            uint32_t flush_loop = code->size;
+            code_append(code, (uint8_t[]){0x4D, 0x85, 0xF6}, 3); //test r14, r14
+            uint32_t flush_empty = x64_jcc(code, X64_JE);
+            x64_mov32(code, X64_EAX, 1);
+            x64_mov32(code, X64_EDI, 1);
+            code_append(code, (uint8_t[]){0x4C, 0x89, 0xF2}, 3); //mov rdx, r14
+            x64_syscall(code);
+            x64_test_rax(code);
+            uint32_t flush_failed = x64_jcc(code, X64_JLE);
+            code_append(code, (uint8_t[]){0x48, 0x01, 0xC6}, 3); //add rsi, rax
+            code_append(code, (uint8_t[]){0x49, 0x29, 0xC6}, 3); //sub r14, rax
+            code_patch_rel32(code, x64_jump(code, X64_JMP), flush_loop);
+            code_patch_rel32(code, flush_empty, code->size);
+            code_patch_rel32(code, flush_failed, code->size);
+            code_append(code, (uint8_t[]){0x45, 0x31, 0xF6, 0xC3}, 4); //xor r14d, r14d, ret
+
+            //input refills in_buf with one large read once it is used up, pending output is flushed before blocking
+            //on end of file the cell is left unchanged
+            uint32_t input = code->size;
+            code_append(code, (uint8_t[]){0x49, 0x39, 0xDF}, 3); //cmp r15, rbx
+            uint32_t input_ready = x64_jcc(code, X64_JNE);
+            code_u8(code, 0x56); //push rsi
+            code_patch_rel32(code, x64_jump(code, X64_CALL), flush);
+            code_append(code, (uint8_t[]){0x31, 0xC0, 0x31, 0xFF}, 4); //xor eax, eax, xor edi, edi
+            x64_mov32(code, X64_ESI, ELF_IN_BUF);
+            x64_mov32(code, X64_EDX, IO_BUFFER_SIZE);
+            x64_syscall(code);
+            code_u8(code, 0x5E); //pop rsi
+            x64_test_rax(code);
+            uint32_t input_eof = x64_jcc(code, X64_JLE);
+            code_append(code, (uint8_t[]){0x48, 0x89, 0xC3, 0x45, 0x31, 0xFF}, 6); //mov rbx, rax, xor r15d, r15d
+            code_patch_rel32(code, input_ready, code->size);
+            code_append(code, (uint8_t[]){0x41, 0x0F, 0xB6, 0x87}, 4); //movzx eax, byte [r15 + in_buf]
+            code_u32(code, ELF_IN_BUF);
+            if(cell_bytes == 2) code_u8(code, 0x66);
+            code_append(code, (uint8_t[]){cell_bytes == 1 ? 0x88 : 0x89, 0x06}, 2); //mov [rsi], al/ax/eax
+            code_append(code, (uint8_t[]){0x49, 0xFF, 0xC7}, 3); //inc r15
+            code_patch_rel32(code, input_eof, code->size);
+            code_u8(code, 0xC3);
+
+            //writes the message at rsi with length rdx to stderr and exits with 1
+            uint32_t fail = code->size;
+            x64_mov32(code, X64_EAX, 1);
+            x64_mov32(code, X64_EDI, 2);
+            x64_syscall(code);
+            x64_mov32(code, X64_EAX, 60);
+            x64_mov32(code, X64_EDI, 1);
+            x64_syscall(code);
+
+            //reports a failed tape allocation
+            uint32_t tape_error = code->size;
+            x64_mov32(code, X64_ESI, data.memory);
+            x64_mov32(code, X64_EDX, data.memory_size);
+            code_patch_rel32(code, x64_jump(code, X64_JMP), fail);
+
+            //an access in a guard region lands here, flush what the program printed and report which end was overrun
+            uint32_t segv_handler = code->size;
+            code_append(code, (uint8_t[]){0x48, 0x8B, 0x5E, 0x10}, 4); //mov rbx, [rsi + 16], the fault address
+            code_patch_rel32(code, x64_jump(code, X64_CALL), flush);
+            x64_mov32(code, X64_ESI, data.overflow);
+            x64_mov32(code, X64_EDX, data.overflow_size);
+            code_append(code, (uint8_t[]){0x4C, 0x39, 0xE3}, 3); //cmp rbx, r12
+            code_patch_rel32(code, x64_jcc(code, X64_JAE), fail);
+            x64_mov32(code, X64_ESI, data.underflow);
+            x64_mov32(code, X64_EDX, data.underflow_size);
+            code_patch_rel32(code, x64_jump(code, X64_JMP), fail);
+            //SA_SIGINFO | SA_RESTORER, the restorer is never returned to
+            elf_patch_sigaction(code, &data, elf_address(segv_handler), 0x04000004, elf_address(segv_handler));
+
+            //the tape is reserved with mmap with inaccessible guard regions on both ends, only the middle is made writable
+            uint64_t guard = tape_guard_size(tokens, cell_bytes);
+            uint64_t tape_size = tape_rounded_size(size);
+            uint32_t entry = code->size;
+            code_append(code, (uint8_t[]){0x45, 0x31, 0xF6, 0x45, 0x31, 0xFF, 0x31, 0xDB}, 8); //xor r14d, r14d, xor r15d, r15d, xor ebx, ebx
+            if(prerun != NULL){
+                //writes what the prerun printed straight from the text segment
+                x64_mov32(code, X64_ESI, elf_address(prerun_output));
+                code_append(code, (uint8_t[]){0x41, 0xBE}, 2); //mov r14d, imm32
+                code_u32(code, prerun->output_size);
+                code_patch_rel32(code, x64_jump(code, X64_CALL), flush_loop);
+                //a progam that finished without input is only that write
+                if(prerun->ip == tokens->size){
+                    x64_mov32(code, X64_EAX, 60);
+                    code_append(code, (uint8_t[]){0x31, 0xFF}, 2); //xor edi, edi
+                    x64_syscall(code);
+                    return entry;
+                }
+            }
+            //mmap(NULL, size, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0)
+            x64_mov32(code, X64_EAX, 9);
+            code_append(code, (uint8_t[]){0x31, 0xFF, 0x48, 0xBE}, 4); //xor edi, edi, mov rsi, imm64
+            code_u64(code, guard + tape_size + guard);
+            code_append(code, (uint8_t[]){0x31, 0xD2, 0x41, 0xBA}, 4); //xor edx, edx, mov r10d, imm32
+            code_u32(code, 0x4022);
+            code_append(code, (uint8_t[]){0x49, 0xC7, 0xC0, 0xFF, 0xFF, 0xFF, 0xFF, 0x45, 0x31, 0xC9}, 10); //mov r8, -1, xor r9d, r9d
+            x64_syscall(code);
+            x64_test_rax(code);
+            code_patch_rel32(code, x64_jcc(code, X64_JS), tape_error);
+            code_append(code, (uint8_t[]){0x49, 0xBC}, 2); //mov r12, imm64
+            code_u64(code, guard);
+            code_append(code, (uint8_t[]){0x49, 0x01, 0xC4}, 3); //add r12, rax
+            //mprotect(r12, tape_size, PROT_READ | PROT_WRITE)
+            x64_mov32(code, X64_EAX, 10);
+            code_append(code, (uint8_t[]){0x4C, 0x89, 0xE7, 0x48, 0xBE}, 5); //mov rdi, r12, mov rsi, imm64
+            code_u64(code, tape_size);
+            x64_mov32(code, X64_EDX, 3);
+            x64_syscall(code);
+            x64_test_rax(code);
+            code_patch_rel32(code, x64_jcc(code, X64_JS), tape_error);
+            //rt_sigaction(SIGSEGV, &segv_action, NULL, sizeof(sigset_t))
+            x64_mov32(code, X64_EAX, 13);
+            x64_mov32(code, X64_EDI, 11);
+            x64_mov32(code, X64_ESI, elf_address(data.segv_action));
+            code_append(code, (uint8_t[]){0x31, 0xD2, 0x41, 0xBA, 0x08, 0x00, 0x00, 0x00}, 8); //xor edx, edx, mov r10d, 8
+            x64_syscall(code);
+            code_append(code, (uint8_t[]){0x45, 0x31, 0xED}, 3); //xor r13d, r13d
+
+            uint32_t resume_jump = 0;
+            if(prerun != NULL){
+                //copies the tape image with rep movsb and continues at the token the prerun stopped at
+                x64_mov32(code, X64_ESI, elf_address(prerun_tape));
+                code_append(code, (uint8_t[]){0x4C, 0x89, 0xE7}, 3); //mov rdi, r12
+                x64_mov32(code, X64_ECX, prerun->tape_cells * cell_bytes);
+                code_append(code, (uint8_t[]){0xF3, 0xA4}, 2); //rep movsb
+                code_append(code, (uint8_t[]){0x49, 0xBD}, 2); //mov r13, imm64
+                code_u64(code, prerun->dp * cell_bytes);
+                resume_jump = x64_jump(code, X64_JMP);
+            }
+
+            uint32_t resume = x64_encode_tokens(code, tokens, cell_bytes, tape_size, print, input, prerun != NULL ? prerun->ip : 0, NULL);
+            if(prerun != NULL) code_patch_rel32(code, resume_jump, resume);
+
+            //exit(0) once the output is flushed
+            code_patch_rel32(code, x64_jump(code, X64_CALL), flush);
+            x64_mov32(code, X64_EAX, 60);
+            code_append(code, (uint8_t[]){0x31, 0xFF}, 2); //xor edi, edi
+            x64_syscall(code);
+            return entry;
+        }
+    #else
+        #define ELF_MACHINE EM_AARCH64
+
+        //aarch64 encodings, the registers match the gas output
+        //X19 the current cell while it is cached (see CellCache), X20 dp, X24 start of the tape
+        //X21 bytes waiting in out_buf, X22 read position in in_buf, X23 bytes in in_buf
+        #define A64_RET 0xD65F03C0
+        #define A64_SVC 0xD4000001
+        #define A64_ADD_IMM 0x91000000 // add Xd, Xn, #imm12
+        #define A64_SUB_IMM 0xD1000000
+        #define A64_ADD_IMM32 0x11000000 // add Wd, Wn, #imm12
+        #define A64_SUB_IMM32 0x51000000
+        #define A64_ADD 0x8B000000 // add Xd, Xn, Xm
+        #define A64_SUB 0xCB000000
+        #define A64_CMP 0xEB00001F // cmp Xn, Xm
+        #define A64_CMP_ZERO 0xF100001F // cmp Xn, #0
+        #define A64_EQ 0
+        #define A64_NE 1
+        #define A64_HS 2
+        #define A64_LT 11
+        #define A64_LE 13
+
+
+        //movz followed by a movk for every other non zero 16 bit chunk
+        void a64_mov_imm(Code* code, uint32_t rd, uint64_t value){
+            code_u32(code, 0xD2800000 | (uint32_t)(value & 0xFFFF) << 5 | rd);
+            for(uint32_t shift = 16; shift < 64; shift += 16){
+                uint32_t chunk = (value >> shift) & 0xFFFF;
+                if(chunk != 0) code_u32(code, 0xF2800000 | (shift / 16) << 21 | chunk << 5 | rd);
+            }
+        }
+
+
+        //mov Xd, Xm
+        void a64_mov(Code* code, uint32_t rd, uint32_t rm){
+            code_u32(code, 0xAA0003E0 | rm << 16 | rd);
+        }
+
+
+        //instructions of the form opcode Rd, Rn, Rm or opcode Rd, Rn, #imm12
+        void a64_reg(Code* code, uint32_t opcode, uint32_t rd, uint32_t rn, uint32_t rm){
+            code_u32(code, opcode | rm << 16 | rn << 5 | rd);
+        }
+
+
+        void a64_imm(Code* code, uint32_t opcode, uint32_t rd, uint32_t rn, uint32_t imm){
+            code_u32(code, opcode | imm << 10 | rn << 5 | rd);
+        }
+
+
+        //add or sub Rd, Rn, value with the immediate opcode, values past 12 bits go through X10
+        void a64_imm_value(Code* code, uint32_t opcode, uint32_t rd, uint32_t rn, uint32_t value){
+            if(value < 4096){
+                a64_imm(code, opcode, rd, rn, value);
+                return;
+            }
+            a64_mov_imm(code, 10, value);
+            //the register form keeps the width and add or sub bits of the immediate opcode
+            a64_reg(code, (opcode & 0xC0000000) | 0x0B000000, rd, rn, 10);
+        }
+
+
+        //ldur/stur of the cell at byte offset from X20, opcode is the form for the cell width
+        //offsets outside the 9 bit signed range are added into X11 first
+        void a64_cell_op(Code* code, uint32_t opcode, uint32_t rt, int32_t offset){
+            uint32_t base = 20;
+            if(offset < -256 || offset > 255){
+                a64_mov_imm(code, 11, (uint64_t)(int64_t)offset);
+                a64_reg(code, A64_ADD, 11, 20, 11);
+                base = 11;
+                offset = 0;
+            }
+            code_u32(code, opcode | ((uint32_t)offset & 0x1FF) << 12 | base << 5 | rt);
+        }
+
+
+        //loads the address of the cell at byte offset from X20 into X1 for print and input
+        void a64_cell_address(Code* code, int32_t offset){
+            if(offset >= 0 && offset < 4096){
+                a64_imm(code, A64_ADD_IMM, 1, 20, offset);
+            } else if(offset < 0 && offset > -4096){
+                a64_imm(code, A64_SUB_IMM, 1, 20, -offset);
+            } else{
+                a64_mov_imm(code, 1, (uint64_t)(int64_t)offset);
+                a64_reg(code, A64_ADD, 1, 20, 1);
+            }
+        }
+
+
+        //b, bl, b.cond, cbz and cbnz with the target patched in later, returns the index of the instruction
+        uint32_t a64_branch(Code* code, uint32_t instruction){
+            code_u32(code, instruction);
+            return code->size - 4;
+        }
+        #define A64_B 0x14000000
+        #define A64_BL 0x94000000
+        #define A64_B_COND(cond) (0x54000000 | (cond))
+        #define A64_CBZ(rt) (0x34000000 | (rt))
+        #define A64_CBNZ(rt) (0x35000000 | (rt))
+        #define A64_CBZ_X(rt) (0xB4000000 | (rt))
+
+
+        //points the branch at index to target
+        void a64_patch_branch(Code* code, uint32_t index, uint32_t target){
+            int64_t distance = ((int64_t)target - (int64_t)index) / 4;
+            uint32_t instruction = code->data[index] | code->data[index + 1] << 8 | code->data[index + 2] << 16 | (uint32_t)code->data[index + 3] << 24;
+            if((instruction & 0x7C000000) == A64_B){
+                if(distance < -(1 << 25) || distance >= (1 << 25)) fatal_error("Program too large for the aarch64 compiler\n");
+                instruction |= distance & 0x3FFFFFF;
+            } else{
+                if(distance < -(1 << 18) || distance >= (1 << 18)) fatal_error("Program too large for the aarch64 compiler\n");
+                instruction |= (distance & 0x7FFFF) << 5;
+            }
+            uint8_t bytes[4] = {instruction, instruction >> 8, instruction >> 16, instruction >> 24};
+            memcpy(code->data + index, bytes, 4);
+        }
+
+
+        //loads the current cell into W19 unless it is already there, load is the ldur for the cell width
+        void a64_cache_load(Code* code, uint32_t load, CellCache* cache){
+            if(cache->cached) return;
+            a64_cell_op(code, load, 19, 0);
+            cache->cached = true;
+            cache->dirty = false;
+        }
+
+
+        //writes W19 back when the cell in memory is older
+        void a64_cache_store(Code* code, uint32_t store, CellCache* cache){
+            if(!cache->dirty) return;
+            a64_cell_op(code, store, 19, 0);
+            cache->dirty = false;
+        }
+
+
+        //before the dp moves or the cell is written in memory
+        void a64_cache_drop(Code* code, uint32_t store, CellCache* cache){
+            a64_cache_store(code, store, cache);
+            cache->cached = false;
+        }
+
+
+        //branches to target when the condition branch is not taken
+        //cbz and cbnz only reach 1MB, so jumps between loop brackets skip over a b instead
+        uint32_t a64_far_branch(Code* code, uint32_t skip){
+            code_u32(code, skip | 2 << 5); //over the b
+            return a64_branch(code, A64_B);
+        }
+
+
+        //encodes the runtime and the program the same way the gas output does and returns the entry point
+        //continuing from a prerun is only implemented for x86_64, main never passes one here
+        uint32_t elf_encode(Code* code, uint32_t size, uint32_t cell_bytes, Tokens* tokens, Prerun* prerun){
+            (void)prerun;
+            ElfData data = elf_encode_data(code, size);
+
+            //ldur/stur for the cell width, the size field is bits 30 and 31
+            uint32_t size_bits = (cell_bytes == 1 ? 0 : cell_bytes == 2 ? 1 : 2) << 30;
+            uint32_t load = 0x38400000 | size_bits;
+            uint32_t store = 0x38000000 | size_bits;
+
+            //print buffers the byte at X1 and flushes once out_buf is full
+            uint32_t print = code->size;
+            code_u32(code, 0x38400000 | 1 << 5 | 9); //ldurb w9, [X1]
+            a64_mov_imm(code, 10, ELF_OUT_BUF);
+            code_u32(code, 0x38206800 | 21 << 16 | 10 << 5 | 9); //strb w9, [X10, X21]
+            a64_imm(code, A64_ADD_IMM, 21, 21, 1);
+            a64_mov_imm(code, 9, IO_BUFFER_SIZE);
+            a64_reg(code, A64_CMP, 0, 21, 9);
+            uint32_t print_full = a64_branch(code, A64_B_COND(A64_EQ));
+            code_u32(code, A64_RET);
+
+            //flush writes out_buf until everything is written or write fails
+            uint32_t flush = code->size;
+            a64_patch_branch(code, print_full, flush);
+            a64_mov_imm(code, 1, ELF_OUT_BUF);
+            uint32_t flush_loop = code->size;
+            uint32_t flush_empty = a64_branch(code, A64_CBZ_X(21));
+            a64_mov_imm(code, 8, 64);
+            a64_mov_imm(code, 0, 1);
+            a64_mov(code, 2, 21);
+            code_u32(code, A64_SVC);
+            a64_reg(code, A64_CMP_ZERO, 0, 0, 0);
+            uint32_t flush_failed = a64_branch(code, A64_B_COND(A64_LE));
+            a64_reg(code, A64_ADD, 1, 1, 0);
+            a64_reg(code, A64_SUB, 21, 21, 0);
+            a64_patch_branch(code, a64_branch(code, A64_B), flush_loop);
+            a64_patch_branch(code, flush_empty, code->size);
+            a64_patch_branch(code, flush_failed, code->size);
+            a64_mov_imm(code, 21, 0);
+            code_u32(code, A64_RET);
+
+            //input refills in_buf with one large read once it is used up, pending output is flushed before blocking
+            //on end of file the cell is left unchanged
+            uint32_t input = code->size;
+            a64_reg(code, A64_CMP, 0, 22, 23);
+            uint32_t input_ready = a64_branch(code, A64_B_COND(A64_NE));
+            a64_mov(code, 12, 30);
+            a64_mov(code, 13, 1);
+            a64_patch_branch(code, a64_branch(code, A64_BL), flush);
+            a64_mov_imm(code, 8, 63);
+            a64_mov_imm(code, 0, 0);
+            a64_mov_imm(code, 1, ELF_IN_BUF);
+            a64_mov_imm(code, 2, IO_BUFFER_SIZE);
+            code_u32(code, A64_SVC);
+            a64_mov(code, 1, 13);
+            a64_mov(code, 30, 12);
+            a64_reg(code, A64_CMP_ZERO, 0, 0, 0);
+            uint32_t input_eof = a64_branch(code, A64_B_COND(A64_LE));
+            a64_mov(code, 23, 0);
+            a64_mov_imm(code, 22, 0);
+            a64_patch_branch(code, input_ready, code->size);
+            a64_mov_imm(code, 10, ELF_IN_BUF);
+            code_u32(code, 0x38606800 | 22 << 16 | 10 << 5 | 9); //ldrb w9, [X10, X22]
+            code_u32(code, store | 1 << 5 | 9); //stur w9, [X1]
+            a64_imm(code, A64_ADD_IMM, 22, 22, 1);
+            a64_patch_branch(code, input_eof, code->size);
+            code_u32(code, A64_RET);
+
+            //writes the message at X1 with length X2 to stderr and exits with 1
+            uint32_t fail = code->size;
+            a64_mov_imm(code, 0, 2);
+            a64_mov_imm(code, 8, 64);
+            code_u32(code, A64_SVC);
+            a64_mov_imm(code, 0, 1);
+            a64_mov_imm(code, 8, 93);
+            code_u32(code, A64_SVC);
+
+            //reports a failed tape allocation
+            uint32_t tape_error = code->size;
+            a64_mov_imm(code, 1, data.memory);
+            a64_mov_imm(code, 2, data.memory_size);
+            a64_patch_branch(code, a64_branch(code, A64_B), fail);
+
+            //an access in a guard region lands here, flush what the program printed and report which end was overrun
+            uint32_t segv_handler = code->size;
+            code_u32(code, 0xF9400000 | 2 << 10 | 1 << 5 | 19); //ldr X19, [X1, #16], the fault address
+            a64_patch_branch(code, a64_branch(code, A64_BL), flush);
+            a64_mov_imm(code, 1, data.overflow);
+            a64_mov_imm(code, 2, data.overflow_size);
+            a64_reg(code, A64_CMP, 0, 19, 24);
+            a64_patch_branch(code, a64_branch(code, A64_B_COND(A64_HS)), fail);
+            a64_mov_imm(code, 1, data.underflow);
+            a64_mov_imm(code, 2, data.underflow_size);
+            a64_patch_branch(code, a64_branch(code, A64_B), fail);
+            //SA_SIGINFO
+            elf_patch_sigaction(code, &data, elf_address(segv_handler), 4, 0);
+
+            //the tape is reserved with mmap with inaccessible guard regions on both ends, only the middle is made writable
+            uint64_t guard = tape_guard_size(tokens, cell_bytes);
+            uint64_t tape_size = tape_rounded_size(size);
+            uint32_t entry = code->size;
+            a64_mov_imm(code, 21, 0);
+            a64_mov_imm(code, 22, 0);
+            a64_mov_imm(code, 23, 0);
+            //mmap(NULL, size, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0)
+            a64_mov_imm(code, 0, 0);
+            a64_mov_imm(code, 1, guard + tape_size + guard);
+            a64_mov_imm(code, 2, 0);
+            a64_mov_imm(code, 3, 0x4022);
+            code_u32(code, 0x92800000 | 4); //mov X4, #-1
+            a64_mov_imm(code, 5, 0);
+            a64_mov_imm(code, 8, 222);
+            code_u32(code, A64_SVC);
+            a64_reg(code, A64_CMP_ZERO, 0, 0, 0);
+            a64_patch_branch(code, a64_branch(code, A64_B_COND(A64_LT)), tape_error);
+            a64_mov_imm(code, 9, guard);
+            a64_reg(code, A64_ADD, 24, 0, 9);
+            a64_mov(code, 20, 24);
+            //mprotect(X24, tape_size, PROT_READ | PROT_WRITE)
+            a64_mov(code, 0, 24);
+            a64_mov_imm(code, 1, tape_size);
+            a64_mov_imm(code, 2, 3);
+            a64_mov_imm(code, 8, 226);
+            code_u32(code, A64_SVC);
+            a64_reg(code, A64_CMP_ZERO, 0, 0, 0);
+            a64_patch_branch(code, a64_branch(code, A64_B_COND(A64_LT)), tape_error);
+            //rt_sigaction(SIGSEGV, &segv_action, NULL, sizeof(sigset_t))
+            a64_mov_imm(code, 0, 11);
+            a64_mov_imm(code, 1, elf_address(data.segv_action));
+            a64_mov_imm(code, 2, 0);
+            a64_mov_imm(code, 3, 8);
+            a64_mov_imm(code, 8, 134);
+            code_u32(code, A64_SVC);
+
+            //like the x86_64 encoder the current cell is in W19 and stored at the loop brackets
+            //cbz needs the bits above an 8 or 16 bit cell cleared, so arithmetic on it is followed by uxtb or uxth
+            Stack bracket_stack = {0};
+            uint32_t mul_add_skip = 0;
+            CellCache cache = {0};
+            for(uint32_t i = 0; i < tokens->size; i++){
+                Token tok = tokens->data[i];
+                switch (tok.type) {
+                    case '>':
+                        a64_cache_drop(code, store, &cache);
+                        a64_imm_value(code, A64_ADD_IMM, 20, 20, tok.amount * cell_bytes);
+                        break;
+                    case '<':
+                        a64_cache_drop(code, store, &cache);
+                        a64_imm_value(code, A64_SUB_IMM, 20, 20, tok.amount * cell_bytes);
+                        break;
+                    case '+':
+                    case '-':
+                        {
+                        uint32_t opcode = tok.type == '+' ? A64_ADD_IMM32 : A64_SUB_IMM32;
+                        if(tok.cell != 0){
+                            a64_cell_op(code, load, 9, tok.cell * cell_bytes);
+                            a64_imm_value(code, opcode, 9, 9, cell_amount(tok, cell_bytes));
+                            a64_cell_op(code, store, 9, tok.cell * cell_bytes);
+                            break;
+                        }
+                        a64_cache_load(code, load, &cache);
+                        a64_imm_value(code, opcode, 19, 19, cell_amount(tok, cell_bytes));
+                        if(cell_bytes == 1) a64_reg(code, 0x53001C00, 19, 19, 0); //uxtb w19, w19
+                        if(cell_bytes == 2) a64_reg(code, 0x53003C00, 19, 19, 0); //uxth w19, w19
+                        cache.dirty = true;
+                        break;
+                        }
+                    case '.':
+                        //print can flush, which leaves X1 pointing into out_buf
+                        if(tok.cell == 0) a64_cache_store(code, store, &cache);
+                        if(tok.amount <= MAX_UNROLLED_PRINTS){
+                            for(uint32_t j = 0; j < tok.amount; j++){
+                                a64_cell_address(code, tok.cell * cell_bytes);
+                                a64_patch_branch(code, a64_branch(code, A64_BL), print);
+                            }
+                            break;
+                        }
+                        //a long run counts down in X14, which print and flush leave alone
+                        a64_mov_imm(code, 14, tok.amount);
+                        uint32_t loop = code->size;
+                        a64_cell_address(code, tok.cell * cell_bytes);
+                        a64_patch_branch(code, a64_branch(code, A64_BL), print);
+                        a64_imm(code, 0xF1000000, 14, 14, 1); //subs X14, X14, #1
+                        a64_patch_branch(code, a64_branch(code, A64_B_COND(A64_NE)), loop);
+                        break;
+                    case ',':
+                        if(tok.cell == 0) a64_cache_drop(code, store, &cache);
+                        a64_cell_address(code, tok.cell * cell_bytes);
+                        a64_patch_branch(code, a64_branch(code, A64_BL), input);
+                        break;
+                    case '[':
+                        a64_cache_load(code, load, &cache);
+                        a64_cache_store(code, store, &cache);
+                        stack_push(&bracket_stack, a64_far_branch(code, A64_CBNZ(19)));
+                        break;
+                    case ']':
+                        {
+                        uint32_t opening = stack_pop(&bracket_stack);
+                        a64_cache_load(code, load, &cache);
+                        a64_cache_store(code, store, &cache);
+                        a64_patch_branch(code, a64_far_branch(code, A64_CBZ(19)), opening + 4);
+                        a64_patch_branch(code, opening, code->size);
+                        break;
+                        }
+                    case TOK_SET_ZERO:
+                        if(tok.cell == 0){
+                            a64_mov_imm(code, 19, 0);
+                            cache.cached = true;
+                            cache.dirty = true;
+                        } else{
+                            a64_cell_op(code, store, 31, tok.cell * cell_bytes); //stur wzr
+                        }
+                        if(i > 0 && tokens->data[i - 1].type == TOK_MUL_ADD) a64_patch_branch(code, mul_add_skip, code->size);
+                        break;
+                    case TOK_MUL_ADD:
+                        {
+                        //a group on another cell may add into the current one, which then has to be in memory on both paths
+                        bool first = i == 0 || tokens->data[i - 1].type != TOK_MUL_ADD;
+                        if(first && tok.cell != 0) a64_cache_drop(code, store, &cache);
+                        uint32_t source = 19;
+                        if(tok.cell == 0){
+                            a64_cache_load(code, load, &cache);
+                        } else{
+                            a64_cell_op(code, load, 12, tok.cell * cell_bytes);
+                            source = 12;
+                        }
+                        if(first) mul_add_skip = a64_far_branch(code, A64_CBNZ(source));
+                        int8_t factor = tok.amount;
+                        if(factor >= 0) code_u32(code, 0x52800000 | (uint32_t)factor << 5 | 9); //movz w9, #factor
+                        else code_u32(code, 0x12800000 | (uint32_t)(~factor & 0xFFFF) << 5 | 9); //movn w9, #~factor
+                        a64_reg(code, 0x1B007C00, 12, source, 9); //mul w12, source, w9
+                        a64_cell_op(code, load, 10, tok.target * cell_bytes);
+                        a64_reg(code, 0x0B000000, 10, 10, 12); //add w10, w10, w12
+                        a64_cell_op(code, store, 10, tok.target * cell_bytes);
+                        break;
+                        }
+                    case TOK_SCAN_RIGHT:
+                    case TOK_SCAN_LEFT:
+                        {
+                        //the test loads every cell into W19 and stops at the zero one, which leaves it cached
+                        a64_cache_store(code, store, &cache);
+                        uint32_t test = a64_branch(code, A64_B);
+                        uint32_t loop = code->size;
+                        a64_imm(code, tok.type == TOK_SCAN_RIGHT ? A64_ADD_IMM : A64_SUB_IMM, 20, 20, tok.amount * cell_bytes);
+                        a64_patch_branch(code, test, code->size);
+                        a64_cell_op(code, load, 19, 0);
+                        a64_patch_branch(code, a64_branch(code, A64_CBNZ(19)), loop);
+                        cache.cached = true;
+                        cache.dirty = false;
+                        break;
+                        }
+                    default:
+                        break;
+                }
+            }
+            stack_delete(&bracket_stack);
+
+            //exit(0) once the output is flushed
+            a64_patch_branch(code, a64_branch(code, A64_BL), flush);
+            a64_mov_imm(code, 0, 0);
+            a64_mov_imm(code, 8, 93);
+            code_u32(code, A64_SVC);
+            return entry;
+        }
+    #endif
+
+
+    //encodes the program and writes it as a static executable, no assembler or linker is needed
+    void elf_progam(const char* output_file, uint32_t size, uint32_t cell_bytes, Tokens* tokens, Prerun* prerun){
+        Code code = code_init();
+        uint32_t entry = elf_encode(&code, size, cell_bytes, tokens, prerun);
+        elf_write(output_file, &code, elf_address(entry), ELF_MACHINE);
+        code_delete(&code);
+    }
+#endif
+
+
+//writes data as a nasm label followed by db lines
+void nasm_bytes(FILE* asm_stream, const char* label, const uint8_t* data, uint32_t size){
+    fprintf(asm_stream, "%s:\n", label);
+    for(uint32_t i = 0; i < size; i += 32){
+        fprintf(asm_stream, "db %u", data[i]);
+        for(uint32_t j = i + 1; j < size && j < i + 32; j++) fprintf(asm_stream, ",%u", data[j]);
+        fprintf(asm_stream, "\n");
+    }
+}
 
-        sprintf(assembly_file,"%s.asm", file_name);
-        sprintf(object_file, "%s.o", assembly_file);
 
-     
-        FILE* asm_stream = fopen(assembly_file, "w");
+//writes a scan in nasm syntax, base holds the tape and dp the byte offset of the current cell
+//the cells are searched 16 bytes at a time with sse2 while the block stays inside the tape_size bytes of the tape
+//and one at a time from the cell the blocks stopped at, like x64_scan_blocks
+void nasm_scan(FILE* asm_stream, Token tok, uint32_t index, uint32_t cell_bytes, const char* base, const char* dp, uint64_t tape_size){
+    bool right = tok.type == TOK_SCAN_RIGHT;
+    const char* cell_size = cell_bytes == 1 ? "byte" : cell_bytes == 2 ? "word" : "dword";
+    const char* move = right ? "add" : "sub";
+    uint32_t byte_stride = tok.amount * cell_bytes;
+    uint32_t lane_count = scan_lane_count(16, byte_stride, cell_bytes);
 
+    if(lane_count >= SCAN_MIN_LANES && tape_size >= 16){
+        fprintf(asm_stream, "cmp %s [%s + %s], 0\nje scan_done%d\npxor xmm1, xmm1\n", cell_size, base, dp, index);
+        if(right){
+            fprintf(asm_stream, "mov rdx, %" PRIu64 "\nscan_block%d:\ncmp %s, rdx\nja scan_test%d\nmovdqu xmm0, [%s + %s]\n", tape_size - 16, index, dp, index, base, dp);
+        } else{
+            //the block ends with the current cell
+            fprintf(asm_stream, "scan_block%d:\ncmp %s, %d\njb scan_test%d\nmovdqu xmm0, [%s + %s - %d]\n", index, dp, 16 - cell_bytes, index, base, dp, 16 - cell_bytes);
+        }
+        fprintf(asm_stream, "pcmpeqb xmm0, xmm1\npmovmskb eax, xmm0\n");
+        //a cell is zero when all of its bytes are
+        if(cell_bytes >= 2) fprintf(asm_stream, "mov ecx, eax\nshr ecx, 1\nand eax, ecx\n");
+        if(cell_bytes == 4) fprintf(asm_stream, "mov ecx, eax\nshr ecx, 2\nand eax, ecx\n");
+        fprintf(asm_stream, "and eax, 0x%" PRIx64 "\njnz scan_found%d\n%s %s, %d\njmp scan_block%d\n", scan_lanes(16, 1, byte_stride, cell_bytes, !right), index, move, dp, lane_count * byte_stride, index);
+        //the zero cell is the lowest lane for right scans and the highest for left scans
+        fprintf(asm_stream, "scan_found%d:\n%s eax, eax\nadd %s, rax\n", index, right ? "bsf" : "bsr", dp);
+        if(!right) fprintf(asm_stream, "sub %s, %d\n", dp, 16 - cell_bytes);
+    }
+    fprintf(asm_stream, "jmp scan_test%d\nscan%d:\n%s %s, %d\nscan_test%d:\ncmp %s [%s + %s], 0\njne scan%d\nscan_done%d:\n", index, index, move, dp, byte_stride, index, cell_size, base, dp, index, index);
+}
 
+#if defined(_WIN64)
+    //continuing from a prerun is only implemented for the unix x86_64 output, main never passes one here
+    void write_assembly(FILE* asm_stream, uint32_t size, uint32_t cell_bytes, Tokens* tokens, Prerun* prerun){
+        (void)prerun;
         fprintf(asm_stream, "global main\nextern fputc\nextern exit\nextern fgetc\nextern __acrt_iob_func\n");
+        //the win64 runtime still uses a fixed tape in .bss, unless tape_bounds gave the size the progam needs
+        if(size == MAX_PROGRAM_SIZE) size = DEFAULT_PROGAM_SIZE;
         fprintf(asm_stream, "section .bss\ncells: resb %d\nsection .text\n main:\n", size);
         //move stdout pointer into r12
         fprintf(asm_stream, "mov rcx, 1\ncall __acrt_iob_func\nmov r12, rax\n");
         //move stdin pointer into r13
         fprintf(asm_stream, "mov rcx, 0\ncall __acrt_iob_func\nmov r13, rax\n");
-        //load dp in r14 and cells pointer in r15
+        //operand size and accumulator register matching the cell width
+        const char* cell_size = cell_bytes == 1 ? "byte" : cell_bytes == 2 ? "word" : "dword";
+        const char* cell_reg = cell_bytes == 1 ? "al" : cell_bytes == 2 ? "ax" : "eax";
+        const char* cell_load = cell_bytes == 4 ? "mov" : "movzx";
+        //load dp in r14 (in bytes) and cells pointer in r15
         fprintf(asm_stream, "mov r14,0\nlea r15, [rel cells]\n");
 
         for(uint32_t i = 0; i < tokens->size; i++){
                 Token tok = tokens->data[i];
                 switch (tok.type) { 
                     case '>':
-                        fprintf(asm_stream, "add r14, %d\n", tok.amount);
+                        fprintf(asm_stream, "add r14, %d\n", tok.amount * cell_bytes);
                         break;
                     case '<':
-                        fprintf(asm_stream, "sub r14, %d\n", tok.amount);
+                        fprintf(asm_stream, "sub r14, %d\n", tok.amount * cell_bytes);
                         break;
                     case '+':
-                        fprintf(asm_stream,"add [r15 + r14], byte %d\n", tok.amount);
+                        fprintf(asm_stream,"add %s [r15 + r14 %+d], %u\n", cell_size, tok.cell * cell_bytes, cell_amount(tok, cell_bytes));
                         break;
                     case '-':
-                        fprintf(asm_stream,"sub [r15 + r14], byte %d\n", tok.amount);
+                        fprintf(asm_stream,"sub %s [r15 + r14 %+d], %u\n", cell_size, tok.cell * cell_bytes, cell_amount(tok, cell_bytes));
                         break;
                     case '.':
-                        for(int i = 0; i < tok.amount; i++){
-                            fprintf(asm_stream, "mov rcx, [r15 + r14]\nmov rdx, r12\ncall fputc\n");
+                        //a long run counts down in ebx, which fputc keeps
+                        if(tok.amount > MAX_UNROLLED_PRINTS) fprintf(asm_stream, "mov ebx, %u\nprint%d:\n", tok.amount, i);
+                        for(uint32_t j = 0; j < (tok.amount > MAX_UNROLLED_PRINTS ? 1 : tok.amount); j++){
+                            fprintf(asm_stream, "movzx rcx, byte [r15 + r14 %+d]\nmov rdx, r12\ncall fputc\n", tok.cell * cell_bytes);
                         }
+                        if(tok.amount > MAX_UNROLLED_PRINTS) fprintf(asm_stream, "dec ebx\njnz print%d\n", i);
                         break;
                     case ',':
-                        fprintf(asm_stream, "mov rcx, r13\ncall fgetc\nmov [r15 + r14], rax\n");
+                        fprintf(asm_stream, "mov rcx, r13\ncall fgetc\nmov [r15 + r14 %+d], %s\n", tok.cell * cell_bytes, cell_reg);
                         break;
                     case '[':
-                        fprintf(asm_stream, "cmp byte [r15 + r14], 0\nje label%d\nlabel%d:\n", tok.offset, i);
+                        fprintf(asm_stream, "cmp %s [r15 + r14], 0\nje label%d\nlabel%d:\n", cell_size, tok.offset, i);
                         break;
                     case ']':
-                        fprintf(asm_stream, "cmp byte [r15 + r14], 0\njne label%d\nlabel%d:\n", tok.offset, i);
+                        fprintf(asm_stream, "cmp %s [r15 + r14], 0\njne label%d\nlabel%d:\n", cell_size, tok.offset, i);
+                        break;
+                    case TOK_SET_ZERO:
+                        fprintf(asm_stream, "mov %s [r15 + r14 %+d], 0\n", cell_size, tok.cell * cell_bytes);
+                        if(i > 0 && tokens->data[i - 1].type == TOK_MUL_ADD) fprintf(asm_stream, "label%d:\n", i);
+                        break;
+                    case TOK_MUL_ADD:
+                        if(i == 0 || tokens->data[i - 1].type != TOK_MUL_ADD){
+                            fprintf(asm_stream, "cmp %s [r15 + r14 %+d], 0\nje label%d\n", cell_size, tok.cell * cell_bytes, mul_add_group_end(tokens, i));
+                        }
+                        fprintf(asm_stream, "%s eax, %s [r15 + r14 %+d]\nimul eax, eax, %d\nadd [r15 + r14 %+d], %s\n", cell_load, cell_size, tok.cell * cell_bytes, (int8_t)tok.amount, tok.target * cell_bytes, cell_reg);
+                        break;
+                    case TOK_SCAN_RIGHT:
+                    case TOK_SCAN_LEFT:
+                        nasm_scan(asm_stream, tok, i, cell_bytes, "r15", "r14", size);
                         break;
                     default:     
                         break;
@@ -295,8 +4849,12 @@ void interpret_progam(Tokens* tokens){
             }
 
 
-        fprintf(asm_stream,"mov rcx, 0\ncall exit");
-        fclose(asm_stream);
+        fprintf(asm_stream,"mov rcx, 0\ncall exit\n");
+    }
+
+
+    //assembles with nasm and links with gcc
+    void assemble_progam(const char* assembly_file, const char* object_file, const char* output_file){
         #define BUF_SIZE 512
         char cmd[BUF_SIZE] = {0};
         int ret;
@@ -311,129 +4869,282 @@ void interpret_progam(Tokens* tokens){
 
         ret = system(cmd);
         if(ret != 0) fatal_error("Failed to execute gcc\n");
-
-        ret = remove(assembly_file);
-        if(ret != 0) fatal_error("Failed to cleanup: %s\n", assembly_file);
-        ret = remove(object_file);
-        if(ret != 0) fatal_error("Failed to cleanup: %s\n", object_file);
-    } 
+    }
 #elif defined(__APPLE__) && defined(__MACH__)  || defined(__linux__)
-    void compile_progam(const char* file_name, const char* output_file, uint32_t size, Tokens* tokens){
-        size_t file_name_len = strlen(file_name) + 5;
-        char assembly_file[file_name_len];
-
-        char object_file[file_name_len + 7];
-
-
-        sprintf(assembly_file,"%s.asm", file_name);
-        sprintf(object_file, "%s.o", assembly_file);
-
-     
-        FILE* asm_stream = fopen(assembly_file, "w");
-
-        if(asm_stream == NULL) fatal_error("Failed to create assembly file\n");
+    #if defined(__aarch64__) || defined(_M_ARM64)
+        //writes the memory operand for the cell at offset from the data pointer (X20) into operand
+        //ldur/stur only take a 9 bit signed offset so cells further away are addressed through X11
+        void aarch64_cell(FILE* asm_stream, int32_t cell, char* operand){
+            if(cell >= -256 && cell <= 255){
+                sprintf(operand, "[X20, #%d]", cell);
+                return;
+            }
+            fprintf(asm_stream, "ldr X11, =%d\nadd X11, X20, X11\n", cell);
+            sprintf(operand, "[X11]");
+        }
 
-        #define BUF_SIZE 512
-        char cmd[BUF_SIZE] = {0};
-        int ret;
-        size_t cmd_len;
- 
+        //loads the address of the cell at offset from the data pointer into X1 for print and input
+        void aarch64_cell_address(FILE* asm_stream, int32_t cell){
+            if(cell >= 0 && cell < 4096){
+                fprintf(asm_stream, "add X1, X20, #%d\n", cell);
+            } else if(cell < 0 && cell > -4096){
+                fprintf(asm_stream, "sub X1, X20, #%d\n", -cell);
+            } else{
+                fprintf(asm_stream, "ldr X1, =%d\nadd X1, X20, X1\n", cell);
+            }
+        }
+    #endif
 
+    void write_assembly(FILE* asm_stream, uint32_t size, uint32_t cell_bytes, Tokens* tokens, Prerun* prerun){
         #if defined(__x86_64__) || defined(_M_X64)
             #if defined (__APPLE__) && defined (__MACH__)
                 int exit_syscall = 0x2000001;
                 int print_syscall = 0x2000004;
                 int input_syscall = 0x2000000;
-                const char* obj_type = "macho64";
+                int mmap_syscall = 0x20000C5;
+                int mprotect_syscall = 0x200004A;
+                int map_flags = 0x1002; //MAP_PRIVATE | MAP_ANON
             #else
                 int exit_syscall = 60;
                 int print_syscall = 1;
                 int input_syscall = 0;
-                const char* obj_type = "elf64";
+                int mmap_syscall = 9;
+                int mprotect_syscall = 10;
+                int map_flags = 0x4022; //MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE
+            #endif
+
+            //operand size and accumulator register matching the cell width
+            const char* cell_size = cell_bytes == 1 ? "byte" : cell_bytes == 2 ? "word" : "dword";
+            const char* cell_reg = cell_bytes == 1 ? "al" : cell_bytes == 2 ? "ax" : "eax";
+            const char* cell_load = cell_bytes == 4 ? "mov" : "movzx";
+
+            fprintf(asm_stream, "global _start\nsection .data\n");
+            fprintf(asm_stream, "memory_msg: db `Error: %s`\n", "Out of Memory\\n");
+            fprintf(asm_stream, "underflow_msg: db `Error: %s`\n", "Data pointer underflow\\n");
+            fprintf(asm_stream, "overflow_msg: db `Error: Max Memory %u bytes Exceeded\\n`\n", size);
+            #if defined(__linux__)
+                //struct sigaction for rt_sigaction: handler, SA_SIGINFO | SA_RESTORER, restorer (never returned to), mask
+                fprintf(asm_stream, "segv_action: dq segv_handler, 0x04000004, segv_handler, 0\n");
+            #endif
+            if(prerun != NULL){
+                nasm_bytes(asm_stream, "prerun_output", prerun->output, prerun->output_size);
+                nasm_bytes(asm_stream, "prerun_tape", prerun->tape, prerun->tape_cells * cell_bytes);
+            }
+            fprintf(asm_stream, "section .bss\n");
+            fprintf(asm_stream, "out_buf: resb %d\nin_buf: resb %d\nsection .text\n", IO_BUFFER_SIZE, IO_BUFFER_SIZE);
+            //r14 bytes waiting in out_buf, r15 read position in in_buf, rbx bytes in in_buf
+            //print buffers the byte at rsi and flushes once out_buf is full
+            fprintf(asm_stream, "print:\nmov al, [rsi]\nlea rdi, [rel out_buf]\nmov [rdi + r14], al\ninc r14\ncmp r14, %d\nje flush\nret\n", IO_BUFFER_SIZE);
+            //flush writes out_buf until everything is written or write fails
+            fprintf(asm_stream, "flush:\nlea rsi, [rel out_buf]\nflush_loop:\ntest r14, r14\njz flush_done\n");
+            fprintf(asm_stream, "mov rax, %d\nmov rdi, 1\nmov rdx, r14\nsyscall\njc flush_done\ntest rax, rax\njle flush_done\n", print_syscall);
+            fprintf(asm_stream, "add rsi, rax\nsub r14, rax\njmp flush_loop\nflush_done:\nxor r14, r14\nret\n");
+            //input refills in_buf with one large read once it is used up, pending output is flushed before blocking
+            //on end of file the cell is left unchanged
+            fprintf(asm_stream, "input:\ncmp r15, rbx\njne input_byte\npush rsi\ncall flush\n");
+            fprintf(asm_stream, "mov rax, %d\nxor edi, edi\nlea rsi, [rel in_buf]\nmov rdx, %d\nsyscall\npop rsi\njc input_eof\n", input_syscall, IO_BUFFER_SIZE);
+            fprintf(asm_stream, "test rax, rax\njle input_eof\nmov rbx, rax\nxor r15, r15\n");
+            fprintf(asm_stream, "input_byte:\nlea rdi, [rel in_buf]\nmovzx eax, byte [rdi + r15]\nmov [rsi], %s\ninc r15\ninput_eof:\nret\n", cell_reg);
+            //reports a failed tape allocation
+            fprintf(asm_stream, "tape_error:\nmov rax, %d\nmov edi, 2\nlea rsi, [rel memory_msg]\nmov rdx, %zu\nsyscall\n", print_syscall, strlen("Error: Out of Memory\n"));
+            fprintf(asm_stream, "mov rax, %d\nmov edi, 1\nsyscall\n", exit_syscall);
+            #if defined(__linux__)
+                //an access in a guard region lands here, flush what the program printed and report which end was overrun
+                fprintf(asm_stream, "segv_handler:\nmov rbx, [rsi + 16]\ncall flush\n");
+                fprintf(asm_stream, "lea rsi, [rel overflow_msg]\nmov rdx, %zu\ncmp rbx, r12\njae segv_report\n", strlen("Error: Max Memory  bytes Exceeded\n") + snprintf(NULL, 0, "%u", size));
+                fprintf(asm_stream, "lea rsi, [rel underflow_msg]\nmov rdx, %zu\n", strlen("Error: Data pointer underflow\n"));
+                fprintf(asm_stream, "segv_report:\nmov rax, %d\nmov edi, 2\nsyscall\nmov rax, %d\nmov edi, 1\nsyscall\n", print_syscall, exit_syscall);
             #endif
 
-            fprintf(asm_stream, "global _start\nsection .bss\ncells: resb %d\nsection .text\n", size);
-            fprintf(asm_stream, "print:\nmov rax,%d\nmov rdi, 1\nmov rdx,1\nsyscall\nret\n", print_syscall);
-            fprintf(asm_stream, "input:\nmov rax, %d\nmov rdi, 0\nmov rdx, 1\nsyscall\nret\n", input_syscall);
-            fprintf(asm_stream, "_start:\nmov r13,0\nlea r12, [rel cells]\n");
+            //the tape is reserved with mmap with inaccessible guard regions on both ends, only the middle is made writable
+            uint64_t guard = tape_guard_size(tokens, cell_bytes);
+            uint64_t tape_size = tape_rounded_size(size);
+            fprintf(asm_stream, "_start:\nxor r14, r14\nxor r15, r15\nxor rbx, rbx\n");
+            if(prerun != NULL){
+                //writes what the prerun printed, a progam that finished without input is only that write
+                fprintf(asm_stream, "lea rsi, [rel prerun_output]\nmov r14, %u\ncall flush_loop\n", prerun->output_size);
+                if(prerun->ip == tokens->size){
+                    fprintf(asm_stream, "mov rax, %d\nxor edi, edi\nsyscall\n", exit_syscall);
+                    return;
+                }
+            }
+            fprintf(asm_stream, "mov rax, %d\nxor edi, edi\nmov rsi, %" PRIu64 "\nxor edx, edx\nmov r10, %d\nmov r8, -1\nxor r9d, r9d\nsyscall\n", mmap_syscall, guard + tape_size + guard, map_flags);
+            fprintf(asm_stream, "jc tape_error\ntest rax, rax\njs tape_error\nmov r12, %" PRIu64 "\nadd r12, rax\n", guard);
+            fprintf(asm_stream, "mov rax, %d\nmov rdi, r12\nmov rsi, %" PRIu64 "\nmov edx, 3\nsyscall\njc tape_error\ntest rax, rax\njs tape_error\n", mprotect_syscall, tape_size);
+            #if defined(__linux__)
+                //rt_sigaction(SIGSEGV, &segv_action, NULL, sizeof(sigset_t))
+                fprintf(asm_stream, "mov rax, 13\nmov edi, 11\nlea rsi, [rel segv_action]\nxor edx, edx\nmov r10, 8\nsyscall\n");
+            #endif
+            //r13 is the dp in bytes
+            fprintf(asm_stream, "mov r13,0\n");
+            if(prerun != NULL){
+                //copies the tape image and continues at the token the prerun stopped at
+                fprintf(asm_stream, "lea rsi, [rel prerun_tape]\nmov rdi, r12\nmov rcx, %u\nrep movsb\n", prerun->tape_cells * cell_bytes);
+                fprintf(asm_stream, "mov r13, %" PRId64 "\njmp resume\n", prerun->dp * cell_bytes);
+            }
 
      
             for(uint32_t i = 0; i < tokens->size; i++){
                 Token tok = tokens->data[i];
+                if(prerun != NULL && i == prerun->ip) fprintf(asm_stream, "resume:\n");
                 switch (tok.type) { 
                     case '>':
-                        fprintf(asm_stream, "add r13, %d\n", tok.amount);
+                        fprintf(asm_stream, "add r13, %d\n", tok.amount * cell_bytes);
                         break;
                     case '<':
-                        fprintf(asm_stream, "sub r13, %d\n", tok.amount);
+                        fprintf(asm_stream, "sub r13, %d\n", tok.amount * cell_bytes);
                         break;
                     case '+':
-                        fprintf(asm_stream,"add [r12 + r13], byte %d\n", tok.amount);
+                        fprintf(asm_stream,"add %s [r12 + r13 %+d], %u\n", cell_size, tok.cell * cell_bytes, cell_amount(tok, cell_bytes));
                         break;
                     case '-':
-                        fprintf(asm_stream,"sub [r12 + r13], byte %d\n", tok.amount);
+                        fprintf(asm_stream,"sub %s [r12 + r13 %+d], %u\n", cell_size, tok.cell * cell_bytes, cell_amount(tok, cell_bytes));
                         break;
                     case '.':
-                        for(int i = 0; i < tok.amount; i++){
-                            fprintf(asm_stream, "lea rsi, [r12 + r13]\ncall print\n");
+                        //a long run counts down on the stack like in the elf writer
+                        if(tok.amount > MAX_UNROLLED_PRINTS) fprintf(asm_stream, "sub rsp, 16\nmov dword [rsp], %u\nprint%d:\n", tok.amount, i);
+                        for(uint32_t j = 0; j < (tok.amount > MAX_UNROLLED_PRINTS ? 1 : tok.amount); j++){
+                            fprintf(asm_stream, "lea rsi, [r12 + r13 %+d]\ncall print\n", tok.cell * cell_bytes);
                         }
+                        if(tok.amount > MAX_UNROLLED_PRINTS) fprintf(asm_stream, "dec dword [rsp]\njnz print%d\nadd rsp, 16\n", i);
                         break;
                     case ',':
-                        fprintf(asm_stream, "lea rsi, [r12 + r13]\ncall input\n");
+                        fprintf(asm_stream, "lea rsi, [r12 + r13 %+d]\ncall input\n", tok.cell * cell_bytes);
                         break;
                     case '[':
-                        fprintf(asm_stream, "cmp byte [r12 + r13], 0\nje label%d\nlabel%d:\n", tok.offset, i);
+                        fprintf(asm_stream, "cmp %s [r12 + r13], 0\nje label%d\nlabel%d:\n", cell_size, tok.offset, i);
                         break;
                     case ']':
-                        fprintf(asm_stream, "cmp byte [r12 + r13], 0\njne label%d\nlabel%d:\n", tok.offset, i);
+                        fprintf(asm_stream, "cmp %s [r12 + r13], 0\njne label%d\nlabel%d:\n", cell_size, tok.offset, i);
+                        break;
+                    case TOK_SET_ZERO:
+                        fprintf(asm_stream, "mov %s [r12 + r13 %+d], 0\n", cell_size, tok.cell * cell_bytes);
+                        if(i > 0 && tokens->data[i - 1].type == TOK_MUL_ADD) fprintf(asm_stream, "label%d:\n", i);
+                        break;
+                    case TOK_MUL_ADD:
+                        if(i == 0 || tokens->data[i - 1].type != TOK_MUL_ADD){
+                            fprintf(asm_stream, "cmp %s [r12 + r13 %+d], 0\nje label%d\n", cell_size, tok.cell * cell_bytes, mul_add_group_end(tokens, i));
+                        }
+                        fprintf(asm_stream, "%s eax, %s [r12 + r13 %+d]\nimul eax, eax, %d\nadd [r12 + r13 %+d], %s\n", cell_load, cell_size, tok.cell * cell_bytes, (int8_t)tok.amount, tok.target * cell_bytes, cell_reg);
+                        break;
+                    case TOK_SCAN_RIGHT:
+                    case TOK_SCAN_LEFT:
+                        nasm_scan(asm_stream, tok, i, cell_bytes, "r12", "r13", tape_size);
                         break;
                     default:     
                         break;
                 }
             } 
             //exit syscall
-            fprintf(asm_stream,"mov rax, %d\nxor rdi,rdi\nsyscall\n", exit_syscall);
-            fclose(asm_stream);
-
-            cmd_len = snprintf(cmd, BUF_SIZE, "nasm -f %s %s -o %s", obj_type, assembly_file, object_file);
-            ret = system(cmd);
-            if(ret != 0) fatal_error("Failed to execute nasm\n");
-
+            fprintf(asm_stream,"call flush\nmov rax, %d\nxor rdi,rdi\nsyscall\n", exit_syscall);
         #elif defined(__aarch64__) || defined(_M_ARM64)   
+            //continuing from a prerun is only implemented for x86_64, main never passes one here
+            (void)prerun;
             #if defined(__linux__)
                 //x19 data value, x20 dp
-                fprintf(asm_stream, ".global _start\n.bss\ncells: .fill %d,1\n.text\n", size);
-                fprintf(asm_stream, "print:\nmov X8,#64\nmov X0, #1\nmov X2,1\nsvc 0\nret\n");
-                fprintf(asm_stream, "input:\nmov X8,#63\nmov X0, #0\nmov X2,1\nsvc 0\nret\n");
-                fprintf(asm_stream, "_start:\nmov X19,0\nldr X20, =cells\n");
+                //load/store suffix matching the cell width, ldurb/ldurh/ldur
+                const char* cell_suffix = cell_bytes == 1 ? "b" : cell_bytes == 2 ? "h" : "";
+                fprintf(asm_stream, ".global _start\n.data\n");
+                fprintf(asm_stream, "memory_msg: .ascii \"Error: Out of Memory\\n\"\n");
+                fprintf(asm_stream, "underflow_msg: .ascii \"Error: Data pointer underflow\\n\"\n");
+                fprintf(asm_stream, "overflow_msg: .ascii \"Error: Max Memory %u bytes Exceeded\\n\"\n", size);
+                //struct sigaction for rt_sigaction: handler, SA_SIGINFO, restorer, mask
+                fprintf(asm_stream, ".balign 8\nsegv_action: .quad segv_handler, 4, 0, 0\n");
+                fprintf(asm_stream, ".bss\n");
+                fprintf(asm_stream, "out_buf: .fill %d,1\nin_buf: .fill %d,1\n.text\n", IO_BUFFER_SIZE, IO_BUFFER_SIZE);
+                //x21 bytes waiting in out_buf, x22 read position in in_buf, x23 bytes in in_buf
+                //print buffers the byte at X1 and flushes once out_buf is full
+                fprintf(asm_stream, "print:\nldrb w9, [X1]\nadrp X10, out_buf\nadd X10, X10, :lo12:out_buf\nstrb w9, [X10, X21]\n");
+                fprintf(asm_stream, "add X21, X21, #1\nmov X9, #%d\ncmp X21, X9\nb.eq flush\nret\n", IO_BUFFER_SIZE);
+                //flush writes out_buf until everything is written or write fails
+                fprintf(asm_stream, "flush:\nadrp X1, out_buf\nadd X1, X1, :lo12:out_buf\nflush_loop:\ncbz X21, flush_done\n");
+                fprintf(asm_stream, "mov X8, #64\nmov X0, #1\nmov X2, X21\nsvc 0\ncmp X0, #0\nb.le flush_done\n");
+                fprintf(asm_stream, "add X1, X1, X0\nsub X21, X21, X0\nb flush_loop\nflush_done:\nmov X21, #0\nret\n");
+                //input refills in_buf with one large read once it is used up, pending output is flushed before blocking
+                //on end of file the cell is left unchanged
+                fprintf(asm_stream, "input:\ncmp X22, X23\nb.ne input_byte\nmov X12, X30\nmov X13, X1\nbl flush\n");
+                fprintf(asm_stream, "mov X8, #63\nmov X0, #0\nadrp X1, in_buf\nadd X1, X1, :lo12:in_buf\nmov X2, #%d\nsvc 0\n", IO_BUFFER_SIZE);
+                fprintf(asm_stream, "mov X1, X13\nmov X30, X12\ncmp X0, #0\nb.le input_eof\nmov X23, X0\nmov X22, #0\n");
+                fprintf(asm_stream, "input_byte:\nadrp X10, in_buf\nadd X10, X10, :lo12:in_buf\nldrb w9, [X10, X22]\nstr%s w9, [X1]\nadd X22, X22, #1\ninput_eof:\nret\n", cell_suffix);
+                //reports a failed tape allocation
+                fprintf(asm_stream, "tape_error:\nmov X0, #2\nadrp X1, memory_msg\nadd X1, X1, :lo12:memory_msg\nmov X2, #%zu\n", strlen("Error: Out of Memory\n"));
+                fprintf(asm_stream, "mov X8, #64\nsvc 0\nmov X0, #1\nmov X8, #93\nsvc 0\n");
+                //an access in a guard region lands here, flush what the program printed and report which end was overrun
+                //x24 holds the start of the tape
+                fprintf(asm_stream, "segv_handler:\nldr X19, [X1, #16]\nbl flush\n");
+                fprintf(asm_stream, "adrp X1, overflow_msg\nadd X1, X1, :lo12:overflow_msg\nmov X2, #%zu\ncmp X19, X24\nb.hs segv_report\n", strlen("Error: Max Memory  bytes Exceeded\n") + snprintf(NULL, 0, "%u", size));
+                fprintf(asm_stream, "adrp X1, underflow_msg\nadd X1, X1, :lo12:underflow_msg\nmov X2, #%zu\n", strlen("Error: Data pointer underflow\n"));
+                fprintf(asm_stream, "segv_report:\nmov X0, #2\nmov X8, #64\nsvc 0\nmov X0, #1\nmov X8, #93\nsvc 0\n");
+
+                //the tape is reserved with mmap with inaccessible guard regions on both ends, only the middle is made writable
+                uint64_t guard = tape_guard_size(tokens, cell_bytes);
+                uint64_t tape_size = tape_rounded_size(size);
+                fprintf(asm_stream, "_start:\nmov X19,0\nmov X21, #0\nmov X22, #0\nmov X23, #0\n");
+                //mmap(NULL, size, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0)
+                fprintf(asm_stream, "mov X0, #0\nldr X1, =%" PRIu64 "\nmov X2, #0\nldr X3, =0x4022\nmov X4, #-1\nmov X5, #0\nmov X8, #222\nsvc 0\ntbnz X0, #63, tape_error\n", guard + tape_size + guard);
+                fprintf(asm_stream, "ldr X9, =%" PRIu64 "\nadd X24, X0, X9\nmov X20, X24\n", guard);
+                fprintf(asm_stream, "mov X0, X24\nldr X1, =%" PRIu64 "\nmov X2, #3\nmov X8, #226\nsvc 0\ntbnz X0, #63, tape_error\n", tape_size);
+                //rt_sigaction(SIGSEGV, &segv_action, NULL, sizeof(sigset_t))
+                fprintf(asm_stream, "mov X0, #11\nadrp X1, segv_action\nadd X1, X1, :lo12:segv_action\nmov X2, #0\nmov X3, #8\nmov X8, #134\nsvc 0\n");
+                char operand[32];
                 for(uint32_t i = 0; i < tokens->size; i++){
                     Token tok = tokens->data[i];
                     switch (tok.type) { 
                         case '>':
-                            fprintf(asm_stream, "add X20, X20, #%d\n", tok.amount);
-                            break;
                         case '<':
-                            fprintf(asm_stream, "sub x20, X20, #%d\n", tok.amount);
+                            //values past the 12 bit immediate go through X9
+                            if(tok.amount * cell_bytes < 4096) fprintf(asm_stream, "%s X20, X20, #%u\n", tok.type == '>' ? "add" : "sub", tok.amount * cell_bytes);
+                            else fprintf(asm_stream, "ldr X9, =%u\n%s X20, X20, X9\n", tok.amount * cell_bytes, tok.type == '>' ? "add" : "sub");
                             break;
                         case '+':
-                            fprintf(asm_stream,"ldrb w19, [X20]\nadd w19, w19,%d\nstrb w19, [X20]\n", tok.amount);
-                            break;
                         case '-':
-                            fprintf(asm_stream,"ldrb w19, [X20]\nsub w19, w19,%d\nstrb w19, [X20]\n", tok.amount);
+                            {
+                            const char* op = tok.type == '+' ? "add" : "sub";
+                            uint32_t amount = cell_amount(tok, cell_bytes);
+                            aarch64_cell(asm_stream, tok.cell * cell_bytes, operand);
+                            if(amount < 4096) fprintf(asm_stream,"ldur%s w19, %s\n%s w19, w19, #%u\nstur%s w19, %s\n", cell_suffix, operand, op, amount, cell_suffix, operand);
+                            else fprintf(asm_stream,"ldur%s w19, %s\nldr w9, =%u\n%s w19, w19, w9\nstur%s w19, %s\n", cell_suffix, operand, amount, op, cell_suffix, operand);
                             break;
+                            }
                         case '.':
-                            for(int i = 0; i < tok.amount; i++){
-                                fprintf(asm_stream, "mov X1, X20\nbl print\n");
+                            //print can flush, which leaves X1 pointing into out_buf, a long run counts down in X14
+                            if(tok.amount > MAX_UNROLLED_PRINTS) fprintf(asm_stream, "ldr X14, =%u\nprint%d:\n", tok.amount, i);
+                            for(uint32_t j = 0; j < (tok.amount > MAX_UNROLLED_PRINTS ? 1 : tok.amount); j++){
+                                aarch64_cell_address(asm_stream, tok.cell * cell_bytes);
+                                fprintf(asm_stream, "bl print\n");
                             }
+                            if(tok.amount > MAX_UNROLLED_PRINTS) fprintf(asm_stream, "subs X14, X14, #1\nb.ne print%d\n", i);
                             break;
                         case ',':
-                            fprintf(asm_stream, "mov X1, X20\nbl input\n");
+                            aarch64_cell_address(asm_stream, tok.cell * cell_bytes);
+                            fprintf(asm_stream, "bl input\n");
                             break;
                         case '[':
-                            fprintf(asm_stream, "ldrb w19, [X20]\ncmp w19, #0\nb.eq label%d\nlabel%d:\n", tok.offset, i);
+                            fprintf(asm_stream, "ldr%s w19, [X20]\ncmp w19, #0\nb.eq label%d\nlabel%d:\n", cell_suffix, tok.offset, i);
                             break;
                         case ']':
-                            fprintf(asm_stream, "ldrb w19, [X20]\ncmp w19, #0\nb.ne label%d\nlabel%d:\n", tok.offset, i);
+                            fprintf(asm_stream, "ldr%s w19, [X20]\ncmp w19, #0\nb.ne label%d\nlabel%d:\n", cell_suffix, tok.offset, i);
+                            break;
+                        case TOK_SET_ZERO:
+                            aarch64_cell(asm_stream, tok.cell * cell_bytes, operand);
+                            fprintf(asm_stream, "stur%s wzr, %s\n", cell_suffix, operand);
+                            if(i > 0 && tokens->data[i - 1].type == TOK_MUL_ADD) fprintf(asm_stream, "label%d:\n", i);
+                            break;
+                        case TOK_MUL_ADD:
+                            aarch64_cell(asm_stream, tok.cell * cell_bytes, operand);
+                            fprintf(asm_stream, "ldur%s w19, %s\n", cell_suffix, operand);
+                            if(i == 0 || tokens->data[i - 1].type != TOK_MUL_ADD){
+                                fprintf(asm_stream, "cbz w19, label%d\n", mul_add_group_end(tokens, i));
+                            }
+                            fprintf(asm_stream, "mov w9, #%d\nmul w19, w19, w9\n", (int8_t)tok.amount);
+                            aarch64_cell(asm_stream, tok.target * cell_bytes, operand);
+                            fprintf(asm_stream, "ldur%s w10, %s\nadd w10, w10, w19\nstur%s w10, %s\n", cell_suffix, operand, cell_suffix, operand);
+                            break;
+                        case TOK_SCAN_RIGHT:
+                            fprintf(asm_stream, "b scan_test%d\nscan%d:\nadd X20, X20, #%d\nscan_test%d:\nldr%s w19, [X20]\ncbnz w19, scan%d\n", i, i, tok.amount * cell_bytes, i, cell_suffix, i);
+                            break;
+                        case TOK_SCAN_LEFT:
+                            fprintf(asm_stream, "b scan_test%d\nscan%d:\nsub X20, X20, #%d\nscan_test%d:\nldr%s w19, [X20]\ncbnz w19, scan%d\n", i, i, tok.amount * cell_bytes, i, cell_suffix, i);
                             break;
                         default:     
                             break;
@@ -441,49 +5152,372 @@ void interpret_progam(Tokens* tokens){
                 }
            
                 //exit
-                fprintf(asm_stream, "mov X0, #0\nmov X8, #93\nsvc 0\n");
-
-                fclose(asm_stream);
-                cmd_len = snprintf(cmd, BUF_SIZE, "as %s -o %s",assembly_file, object_file);
-                ret = system(cmd);
-                if(ret != 0) fatal_error("Failed to execute gnu assembler\n");
+                fprintf(asm_stream, "bl flush\nmov X0, #0\nmov X8, #93\nsvc 0\n");
             #else  
-                fclose(asm_stream);
                 fatal_error("Compiler not supported for ARM based Macos\n");
             #endif
         #else
-            fclose(asm_stream);
             fatal_error("Compiler not supported for this CPU architecture\n");
         #endif
+    }
+
 
+    //assembles with nasm or the gnu assembler and links with ld
+    void assemble_progam(const char* assembly_file, const char* object_file, const char* output_file){
+        #define BUF_SIZE 512
+        char cmd[BUF_SIZE] = {0};
+        int ret;
+        size_t cmd_len;
 
+        #if defined(__x86_64__) || defined(_M_X64)
+            #if defined (__APPLE__) && defined (__MACH__)
+                const char* obj_type = "macho64";
+            #else
+                const char* obj_type = "elf64";
+            #endif
+            cmd_len = snprintf(cmd, BUF_SIZE, "nasm -f %s %s -o %s", obj_type, assembly_file, object_file);
+            ret = system(cmd);
+            if(ret != 0) fatal_error("Failed to execute nasm\n");
+        #else
+            cmd_len = snprintf(cmd, BUF_SIZE, "as %s -o %s",assembly_file, object_file);
+            ret = system(cmd);
+            if(ret != 0) fatal_error("Failed to execute gnu assembler\n");
+        #endif
 
         memset(cmd,0, cmd_len + 1);
         snprintf(cmd, BUF_SIZE, "ld -e _start -static -o %s %s", output_file, object_file);
 
         ret = system(cmd);
         if(ret != 0) fatal_error("Failed to execute ld\n");
+    }
+#else
+    void write_assembly(FILE* asm_stream, uint32_t size, uint32_t cell_bytes, Tokens* tokens, Prerun* prerun){
+        fatal_error("The compiler is not supported for this platform\n");
+    }
+
+
+    void assemble_progam(const char* assembly_file, const char* object_file, const char* output_file){
+        fatal_error("The compiler is not supported for this platform\n");
+    }
+#endif
+
+
+//writes the assembly of the program into assembly_file
+void emit_assembly(const char* assembly_file, uint32_t size, uint32_t cell_bytes, Tokens* tokens, Prerun* prerun){
+    FILE* asm_stream = fopen(assembly_file, "w");
+    if(asm_stream == NULL) fatal_error("Failed to create assembly file\n");
+    write_assembly(asm_stream, size, cell_bytes, tokens, prerun);
+    fclose(asm_stream);
+}
+
+void compile_progam(const char* file_name, const char* output_file, uint32_t size, uint32_t cell_bytes, Tokens* tokens, Prerun* prerun){
+    #if defined(ELF_WRITER)
+        (void)file_name;
+        elf_progam(output_file, size, cell_bytes, tokens, prerun);
+    #else
+        size_t file_name_len = strlen(file_name) + 5;
+        char assembly_file[file_name_len];
+
+        char object_file[file_name_len + 7];
+
 
+        sprintf(assembly_file,"%s.asm", file_name);
+        sprintf(object_file, "%s.o", assembly_file);
 
-        ret = remove(assembly_file);
+        emit_assembly(assembly_file, size, cell_bytes, tokens, prerun);
+        assemble_progam(assembly_file, object_file, output_file);
+
+        int ret = remove(assembly_file);
         if(ret != 0) fatal_error("Failed to cleanup: %s\n", assembly_file);
         ret = remove(object_file);
         if(ret != 0) fatal_error("Failed to cleanup: %s\n", object_file);
+    #endif
+}
 
-    } 
-#else
-    void compile_progam(const char* file_name, const char* output_file, uint32_t size, Tokens* tokens){
-        fatal_error("The compiler is not supported for this platform\n");
+
+
+//--emit-c translates the tokens into a C progam and builds it with the system C compiler
+//the tape is one array addressed through the data pointer p and loops become while loops
+//so the C compiler sees the whole progam and can keep cells in registers and optimize the loops itself
+//instead of guard pages the data pointer is checked against the cells the following instructions use wherever it changes
+
+//lowest and highest cell the instructions from index up to the next move, bracket, scan or io access
+//io ends the range so everything printed before an access outside the tape still comes out
+//MUL_ADD targets are left out, they are only touched when the cell is not zero and checked there
+//returns false when there is nothing to check
+bool c_segment_range(Tokens* tokens, uint32_t index, int64_t* low, int64_t* high){
+    bool used = false;
+    *low = 0;
+    *high = 0;
+    for(uint32_t i = index; i < tokens->size; i++){
+        Token tok = tokens->data[i];
+        switch (tok.type) {
+            case '>':
+            case '<':
+                return used;
+            case '[':
+            case ']':
+            case TOK_SCAN_RIGHT:
+            case TOK_SCAN_LEFT:
+                //the cell at the data pointer is read, low and high start at it
+                if(used && *low > 0) *low = 0;
+                if(used && *high < 0) *high = 0;
+                return true;
+            default:
+                if(!used || tok.cell < *low) *low = tok.cell;
+                if(!used || tok.cell > *high) *high = tok.cell;
+                used = true;
+                if(tok.type == '.' || tok.type == ',') return true;
+                break;
+        }
     }
-#endif
+    return used;
+}
+
+
+//loops nested deeper than this are not indented further, the source would grow with the square of the nesting
+#define MAX_C_INDENT 32
+
+void c_indent(FILE* c_stream, uint32_t depth){
+    fprintf(c_stream, "%*s", 4 * ((depth < MAX_C_INDENT ? depth : MAX_C_INDENT) + 1), "");
+}
+
+
+void write_c(FILE* c_stream, uint32_t size, uint32_t cell_bytes, Tokens* tokens, Prerun* prerun){
+    const char* cell_type = cell_bytes == 1 ? "uint8_t" : cell_bytes == 2 ? "uint16_t" : "uint32_t";
+    uint32_t mask = cell_bytes == 4 ? UINT32_MAX : (1u << 8 * cell_bytes) - 1;
+
+    fprintf(c_stream, "#include <stdio.h>\n#include <stdlib.h>\n#include <stddef.h>\n#include <stdint.h>\n#include <string.h>\n");
+    fprintf(c_stream, "#if defined(__unix__) || defined(__APPLE__)\n#include <sys/mman.h>\n#include <unistd.h>\n#include <signal.h>\n#endif\n\n");
+    fprintf(c_stream, "typedef %s cell;\n#define TAPE_CELLS %" PRIu64 "\n", cell_type, (uint64_t)size / cell_bytes);
+    fprintf(c_stream, "#define GUARD_BYTES %" PRIu64 "\n\n", tape_guard_size(tokens, cell_bytes));
+    //like the other backends the tape sits between guard pages where the system has them
+    //and a fault in a guard is reported, anywhere else every access range is checked instead
+    fprintf(c_stream, "#if defined(MAP_ANONYMOUS) && defined(MAP_NORESERVE) && defined(SA_SIGINFO)\n#define GUARDED 1\n#endif\n\n");
+    fprintf(c_stream, "static unsigned char out_buf[%d];\nstatic size_t out_size;\n\n", IO_BUFFER_SIZE);
+    fprintf(c_stream, "static void flush_output(void){\n    fwrite(out_buf, 1, out_size, stdout);\n    fflush(stdout);\n    out_size = 0;\n}\n\n");
+    fprintf(c_stream, "static void print(cell c){\n    out_buf[out_size++] = (unsigned char)c;\n    if(out_size == sizeof(out_buf)) flush_output();\n}\n\n");
+    //input is read in large blocks where read is available, end of input reads as -1 like in the interpreter
+    fprintf(c_stream, "#if defined(_POSIX_VERSION)\nstatic unsigned char in_buf[%d];\nstatic size_t in_size, in_position;\n#endif\n\n", IO_BUFFER_SIZE);
+    fprintf(c_stream, "static cell input(void){\n    if(out_size > 0) flush_output();\n#if defined(_POSIX_VERSION)\n");
+    fprintf(c_stream, "    if(in_position == in_size){\n        ssize_t count = read(0, in_buf, sizeof(in_buf));\n        if(count <= 0) return (cell)-1;\n");
+    fprintf(c_stream, "        in_size = count;\n        in_position = 0;\n    }\n    return in_buf[in_position++];\n#else\n    return (cell)getchar();\n#endif\n}\n\n");
+    fprintf(c_stream, "#define UNDERFLOW_MESSAGE \"Error: Data pointer underflow\\n\"\n#define OVERFLOW_MESSAGE \"Error: Max Memory %u bytes Exceeded\\n\"\n\n", size);
+    fprintf(c_stream, "static void tape_fault(int underflow){\n    flush_output();\n    fputs(underflow ? UNDERFLOW_MESSAGE : OVERFLOW_MESSAGE, stderr);\n    exit(1);\n}\n\n");
+    fprintf(c_stream, "#if defined(GUARDED)\nstatic char* memory_start;\nstatic char* memory_end;\nstatic char* tape_start;\n\n");
+    //only async signal safe calls, the buffered output is written before the error like in the other backends
+    fprintf(c_stream, "static void tape_signal(int signal_number, siginfo_t* info, void* context){\n    char* address = info->si_addr;\n    (void)context;\n");
+    fprintf(c_stream, "    if(address < memory_start || address >= memory_end){\n        signal(signal_number, SIG_DFL);\n        return;\n    }\n");
+    fprintf(c_stream, "    const char* message = address < tape_start ? UNDERFLOW_MESSAGE : OVERFLOW_MESSAGE;\n    size_t written = 0;\n");
+    fprintf(c_stream, "    while(written < out_size){\n        ssize_t count = write(1, out_buf + written, out_size - written);\n        if(count <= 0) break;\n        written += count;\n    }\n");
+    fprintf(c_stream, "    ssize_t ignored = write(2, message, strlen(message));\n    (void)ignored;\n    _exit(1);\n}\n\n");
+    fprintf(c_stream, "static cell* tape_create(void){\n    size_t size = ((size_t)TAPE_CELLS * sizeof(cell) / 65536 + 1) * 65536;\n");
+    fprintf(c_stream, "    char* memory = mmap(NULL, GUARD_BYTES + size + GUARD_BYTES, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);\n");
+    fprintf(c_stream, "    if(memory == MAP_FAILED || mprotect(memory + GUARD_BYTES, size, PROT_READ | PROT_WRITE) != 0) return NULL;\n");
+    fprintf(c_stream, "    memory_start = memory;\n    memory_end = memory + GUARD_BYTES + size + GUARD_BYTES;\n    tape_start = memory + GUARD_BYTES;\n\n");
+    fprintf(c_stream, "    struct sigaction action;\n    memset(&action, 0, sizeof(action));\n    action.sa_sigaction = tape_signal;\n    action.sa_flags = SA_SIGINFO;\n");
+    fprintf(c_stream, "    sigaction(SIGSEGV, &action, NULL);\n    sigaction(SIGBUS, &action, NULL);\n    return (cell*)tape_start;\n}\n\n#define CHECK(low, high)\n#else\n");
+    fprintf(c_stream, "static cell* tape_create(void){\n    return calloc(TAPE_CELLS, sizeof(cell));\n}\n\n");
+    fprintf(c_stream, "#define CHECK(low, high) { ptrdiff_t at = p - tape; if(at + (low) < 0 || at + (high) >= (ptrdiff_t)TAPE_CELLS) tape_fault(at + (low) < 0); }\n#endif\n\n");
+
+    if(prerun != NULL){
+        fprintf(c_stream, "static const unsigned char prerun_output[] = {0");
+        for(uint32_t i = 0; i < prerun->output_size; i++) fprintf(c_stream, i % 32 == 0 ? ",\n%u" : ",%u", prerun->output[i]);
+        fprintf(c_stream, "};\nstatic const unsigned char prerun_tape[] = {0");
+        for(uint32_t i = 0; i < prerun->tape_cells * cell_bytes; i++) fprintf(c_stream, i % 32 == 0 ? ",\n%u" : ",%u", prerun->tape[i]);
+        fprintf(c_stream, "};\n\n");
+    }
+
+    fprintf(c_stream, "int main(void){\n    cell* tape = tape_create();\n");
+    fprintf(c_stream, "    if(tape == NULL){\n        fputs(\"Error: Out of Memory\\n\", stderr);\n        return 1;\n    }\n    cell* p = tape;\n");
+    uint32_t resume = UINT32_MAX;
+    if(prerun != NULL){
+        //the arrays start with a dummy byte so they are never empty
+        fprintf(c_stream, "    fwrite(prerun_output + 1, 1, %u, stdout);\n    fflush(stdout);\n", prerun->output_size);
+        if(prerun->ip == tokens->size){
+            fprintf(c_stream, "    return 0;\n}\n");
+            return;
+        }
+        fprintf(c_stream, "    memcpy(tape, prerun_tape + 1, %u);\n", prerun->tape_cells * cell_bytes);
+        fprintf(c_stream, "    p = tape + %" PRId64 ";\n    goto resume;\n", prerun->dp);
+        resume = prerun->ip;
+    }
+
+    //segments where tape_bounds knows the data pointer are only checked when they could leave the tape
+    int64_t* positions = malloc(((size_t)tokens->size + 1) * sizeof(int64_t));
+    if(positions == NULL) fatal_error(OUT_OF_MEM);
+    uint64_t cells;
+    tape_bounds(tokens, positions, &cells);
+
+    uint32_t depth = 0;
+    for(uint32_t i = 0; i < tokens->size; i++){
+        Token tok = tokens->data[i];
+        if(i == resume){
+            c_indent(c_stream, depth);
+            fprintf(c_stream, "resume:;\n");
+        }
+        TokenType previous = i > 0 ? tokens->data[i - 1].type : TOK_INVALID;
+        bool segment_start = i == 0 || i == resume || previous == '>' || previous == '<' || previous == '[' || previous == ']'
+            || previous == TOK_SCAN_RIGHT || previous == TOK_SCAN_LEFT || previous == '.' || previous == ',';
+        int64_t low, high;
+        if(segment_start && tok.type != '>' && tok.type != '<' && c_segment_range(tokens, i, &low, &high)
+            && (positions[i] == TAPE_UNKNOWN || positions[i] + low < 0 || positions[i] + high >= (int64_t)(size / cell_bytes))){
+            c_indent(c_stream, depth);
+            fprintf(c_stream, "CHECK(%" PRId64 ", %" PRId64 ")\n", low, high);
+        }
+
+        switch (tok.type) {
+            case '>':
+            case '<':
+                {
+                //consecutive moves become one, unless the progam resumes in between
+                int64_t move = 0;
+                uint32_t j = i;
+                for(; j < tokens->size && (j == i || j != resume); j++){
+                    Token step = tokens->data[j];
+                    if(step.type == '>') move += step.amount;
+                    else if(step.type == '<') move -= step.amount;
+                    else break;
+                }
+                i = j - 1;
+                c_indent(c_stream, depth);
+                fprintf(c_stream, "p += %" PRId64 ";\n", move);
+                break;
+                }
+            case '+':
+            case '-':
+                {
+                //long runs are split over several tokens, they become one add like the moves
+                uint64_t add = 0;
+                uint32_t j = i;
+                for(; j < tokens->size && (j == i || j != resume); j++){
+                    Token step = tokens->data[j];
+                    if(step.cell != tok.cell) break;
+                    if(step.type == '+') add += step.amount;
+                    else if(step.type == '-') add -= step.amount;
+                    else break;
+                }
+                i = j - 1;
+                c_indent(c_stream, depth);
+                fprintf(c_stream, "p[%d] += %" PRIu64 "u;\n", tok.cell, add & mask);
+                break;
+                }
+            case '.':
+                c_indent(c_stream, depth);
+                if(tok.amount == 1) fprintf(c_stream, "print(p[%d]);\n", tok.cell);
+                else fprintf(c_stream, "for(uint32_t n = 0; n < %uu; n++) print(p[%d]);\n", tok.amount, tok.cell);
+                break;
+            case ',':
+                c_indent(c_stream, depth);
+                fprintf(c_stream, "p[%d] = input();\n", tok.cell);
+                break;
+            case '[':
+                c_indent(c_stream, depth);
+                fprintf(c_stream, "while(*p){\n");
+                depth++;
+                break;
+            case ']':
+                depth--;
+                c_indent(c_stream, depth);
+                fprintf(c_stream, "}\n");
+                break;
+            case TOK_SET_ZERO:
+                c_indent(c_stream, depth);
+                fprintf(c_stream, "p[%d] = 0;\n", tok.cell);
+                break;
+            case TOK_MUL_ADD:
+                {
+                //the whole group is written at its first instruction, the targets are only touched when the cell is not zero
+                uint32_t end = mul_add_group_end(tokens, i);
+                int32_t target_low = tok.target;
+                int32_t target_high = tok.target;
+                for(uint32_t j = i; j < end; j++){
+                    if(tokens->data[j].target < target_low) target_low = tokens->data[j].target;
+                    if(tokens->data[j].target > target_high) target_high = tokens->data[j].target;
+                }
+                c_indent(c_stream, depth);
+                fprintf(c_stream, "if(p[%d]){\n", tok.cell);
+                c_indent(c_stream, depth + 1);
+                fprintf(c_stream, "cell value = p[%d];\n", tok.cell);
+                if(positions[i] == TAPE_UNKNOWN || positions[i] + target_low < 0 || positions[i] + target_high >= (int64_t)(size / cell_bytes)){
+                    c_indent(c_stream, depth + 1);
+                    fprintf(c_stream, "CHECK(%d, %d)\n", target_low, target_high);
+                }
+                for(uint32_t j = i; j < end; j++){
+                    Token add = tokens->data[j];
+                    c_indent(c_stream, depth + 1);
+                    fprintf(c_stream, "p[%d] += value * %uu;\n", add.target, (uint32_t)(int32_t)(int8_t)add.amount & mask);
+                }
+                c_indent(c_stream, depth);
+                fprintf(c_stream, "}\n");
+                i = end - 1;
+                break;
+                }
+            case TOK_SCAN_RIGHT:
+                c_indent(c_stream, depth);
+                if(cell_bytes == 1 && tok.amount == 1){
+                    fprintf(c_stream, "p = memchr(p, 0, TAPE_CELLS - (p - tape));\n");
+                    c_indent(c_stream, depth);
+                    fprintf(c_stream, "if(p == NULL) tape_fault(0);\n");
+                } else{
+                    fprintf(c_stream, "while(*p){ p += %u; CHECK(0, 0) }\n", tok.amount);
+                }
+                break;
+            case TOK_SCAN_LEFT:
+                c_indent(c_stream, depth);
+                fprintf(c_stream, "while(*p){ p -= %u; CHECK(0, 0) }\n", tok.amount);
+                break;
+            default:
+                break;
+        }
+    }
+    fprintf(c_stream, "    flush_output();\n    return 0;\n}\n");
+    free(positions);
+}
+
+
+//an output file ending in .c only gets the C source, anything else is built with $CC or gcc
+void c_progam(const char* file_name, const char* output_file, uint32_t size, uint32_t cell_bytes, Tokens* tokens, Prerun* prerun){
+    size_t output_len = strlen(output_file);
+    bool source_only = output_len > 2 && strcmp(output_file + output_len - 2, ".c") == 0;
+    char c_file[strlen(file_name) + 3];
+    sprintf(c_file, "%s.c", file_name);
+
+    FILE* c_stream = fopen(source_only ? output_file : c_file, "w");
+    if(c_stream == NULL) fatal_error("Failed to create C file\n");
+    write_c(c_stream, size, cell_bytes, tokens, prerun);
+    fclose(c_stream);
+    if(source_only) return;
+
+    const char* compiler = getenv("CC");
+    if(compiler == NULL || compiler[0] == '\0') compiler = "gcc";
+    size_t cmd_size = strlen(compiler) + strlen(c_file) + output_len + 16;
+    char cmd[cmd_size];
+    snprintf(cmd, cmd_size, "%s -O2 -o %s %s", compiler, output_file, c_file);
+    int ret = system(cmd);
+    if(remove(c_file) != 0) fatal_error("Failed to cleanup: %s\n", c_file);
+    if(ret != 0) fatal_error("Failed to execute %s\n", compiler);
+}
 
 
 void usage(){
     fprintf(stderr, "./brainfck {input file}\n");
     fprintf(stderr, "Flags: \n");
     fprintf(stderr, "-c, Compiles the progam (Redunant if using -o)\n");
+    fprintf(stderr, "--jit, Compiles the progam in memory and runs it (x86_64 Linux and Macos)\n");
+    fprintf(stderr, "--tiered, Interprets the progam and compiles its hot loops in memory (x86_64 Linux and Macos)\n");
+    fprintf(stderr, "--emit-asm, Writes the assembly of the progam to {input file}.asm or the -o file instead of compiling it\n");
+    fprintf(stderr, "--emit-c, Compiles the progam through C with $CC or gcc -O2 into the -o file (Default a.out), a -o file ending in .c only gets the C source\n");
+    fprintf(stderr, "--profile, Interprets the progam and reports the hottest loops and instructions with their source line and column\n");
+    fprintf(stderr, "--stats, Writes the executed instructions, loop iterations, io bytes, tape use and cpu counters of the run as json to stderr (interpreter and --jit)\n");
+    fprintf(stderr, "--cache, Keeps the parsed progam in {input file}.bfc and reuses it while the source is unchanged\n");
+    fprintf(stderr, "--prerun, Runs the progam up to its first input when compiling and bakes the output and tape into the executable (x86_64 Linux and Macos, the interpreter needs --cache)\n");
     fprintf(stderr, "Options: \n");
     fprintf(stderr, "-o {output file}, Compiles the progam into an executable named {output_name}\n");
+    fprintf(stderr, "--cell-bits {8|16|32}, Width of a tape cell (Default 8)\n");
+    fprintf(stderr, "--batch {manifest}, Interprets every {progam file} [{input file}] [{output file}] line of the manifest on a thread pool, outputs are written in manifest order\n");
+    fprintf(stderr, "--threads {n}, Number of threads --batch runs on and large sources are parsed with (Default one per cpu)\n");
+    fprintf(stderr, "--prerun-steps {n}, Like --prerun but stops after n instructions (Default 100000000)\n");
 }
 
 
@@ -496,121 +5530,198 @@ int main(int argc, char** argv){
         return 1;
     }
 
-    char* output_name = "a.out";
+    char* output_name = NULL;
     char* file_name = NULL;
+    bool emit_asm = false;
+    bool emit_c = false;
+    bool profile = false;
+    bool stats = false;
+    bool cache = false;
+    uint64_t prerun_steps = 0;
+    char* batch_file = NULL;
+    uint32_t threads = 0;
+
 
+    typedef enum {
+        RUN_INTERPRETER,
+        RUN_COMPILER,
+        RUN_JIT,
+        RUN_TIERED,
+        RUN_EMIT_ASM,
+        RUN_EMIT_C
+    } RunMode;
 
-    bool interpret = true;
+    RunMode mode = RUN_INTERPRETER;
+    uint32_t cell_bytes = 1;
 
     int arg_index = 1;
     while(arg_index < argc){
         char* arg = argv[arg_index];
         
         if(strcmp(arg, "-o") == 0){
-            interpret = false;
+            mode = RUN_COMPILER;
             if(arg_index + 1 == argc){
-                warning("No output file provided but -o flag was passed. Defaulting to %s\n", output_name);
+                warning("No output file provided but -o flag was passed. Defaulting to %s\n", "a.out");
                 break;
             }
             arg_index++;
             output_name = argv[arg_index]; 
 
         } else if(strcmp(arg, "-c") == 0){
-            interpret = false;
+            mode = RUN_COMPILER;
 
-        } else if(strcmp(arg, "--help") == 0){
-            usage();
-            return 1;
-        } else{
-            file_name = arg;
-        }
+        } else if(strcmp(arg, "--jit") == 0){
+            mode = RUN_JIT;
 
-        arg_index++;
-    }
+        } else if(strcmp(arg, "--tiered") == 0){
+            mode = RUN_TIERED;
 
-    if(file_name == NULL) fatal_error("No input file\n");
-     
+        } else if(strcmp(arg, "--emit-asm") == 0){
+            emit_asm = true;
 
-    FILE* stream = fopen(file_name, "r");
-    if(stream == NULL){
-        fprintf(stderr,"Failed to open: %s\n", file_name);
-        perror("");
-        return 1;
-    }
+        } else if(strcmp(arg, "--emit-c") == 0){
+            emit_c = true;
 
+        } else if(strcmp(arg, "--profile") == 0){
+            profile = true;
 
-    Tokens tokens = tokens_init();
-    Stack bracket_stack = {0};
-    uint32_t line_count = 1;
+        } else if(strcmp(arg, "--stats") == 0){
+            stats = true;
 
+        } else if(strcmp(arg, "--cache") == 0){
+            cache = true;
 
-    uint64_t number = 0;
+        } else if(strcmp(arg, "--prerun") == 0){
+            prerun_steps = PRERUN_DEFAULT_STEPS;
 
-    while(true){
-        char c = fgetc(stream);
+        } else if(strcmp(arg, "--prerun-steps") == 0){
+            if(arg_index + 1 == argc) fatal_error("No step count provided but --prerun-steps flag was passed\n");
+            arg_index++;
+            char* end;
+            prerun_steps = strtoull(argv[arg_index], &end, 10);
+            if(*end != '\0' || prerun_steps == 0) fatal_error("Invalid step count %s\n", argv[arg_index]);
 
-        if(feof(stream)) break;
+        } else if(strcmp(arg, "--batch") == 0){
+            if(arg_index + 1 == argc) fatal_error("No manifest provided but --batch flag was passed\n");
+            arg_index++;
+            batch_file = argv[arg_index];
 
-        switch (c) {
-            case '>':
-            case '<':
-            case '+':
-            case '-':
-            case '.':
-            case ',':
-                check_continous_tokens(stream, c, &tokens, number, line_count);
-                number = 0;
-                break;
-            case '[':
-                if(number != 0) warning(NUMBER_WARNING, c, line_count, number,c, number);
-                number = 0;
-                tokens_append(&tokens, (Token){c, .offset= 0});
-                stack_push(&bracket_stack, tokens.size - 1);
-                break;                     
-            case ']':
-                {
-                if(number != 0) warning(NUMBER_WARNING, c, line_count, number,c, number);
-                if(bracket_stack.size < 1) fatal_error("Mismatched Brackets on Line %d\n", line_count); 
-                 uint32_t opening_index = stack_pop(&bracket_stack);
-                 Token end_bracket = {c, .offset = opening_index};
-                 tokens_append(&tokens, end_bracket);
+        } else if(strcmp(arg, "--threads") == 0){
+            if(arg_index + 1 == argc) fatal_error("No thread count provided but --threads flag was passed\n");
+            arg_index++;
+            char* end;
+            unsigned long count = strtoul(argv[arg_index], &end, 10);
+            if(*end != '\0' || count == 0 || count > 4096) fatal_error("Invalid thread count %s\n", argv[arg_index]);
+            threads = count;
 
-                 //have the offset of the opening brace point to the end_bracket index
-                 tokens.data[opening_index].offset = tokens.size - 1;
+        } else if(strcmp(arg, "--cell-bits") == 0){
+            if(arg_index + 1 == argc) fatal_error("No cell width provided but --cell-bits flag was passed\n");
+            arg_index++;
+            char* bits = argv[arg_index];
+            if(strcmp(bits, "8") == 0) cell_bytes = 1;
+            else if(strcmp(bits, "16") == 0) cell_bytes = 2;
+            else if(strcmp(bits, "32") == 0) cell_bytes = 4;
+            else fatal_error("Unsupported cell width %s, expected 8, 16 or 32\n", bits);
 
-                 break;
-                }
-            case '\n':
-                line_count++;
-                break;
-            default:
-                if(isdigit(c)){
-                    while(true){
-                        number = number * 10 + (c - 48);
-                        fpos_t pos;
-                        fgetpos(stream, &pos);
-                        char next_char = fgetc(stream);
-                        fsetpos(stream, &pos);
+        } else if(strcmp(arg, "--help") == 0){
+            usage();
+            return 1;
+        } else{
+            file_name = arg;
+        }
 
-                        if(!isdigit(next_char)) break;
-                        c = fgetc(stream);
+        arg_index++;
+    }
 
-                    }
-                    if(number > 255) warning("Numbers larger than 255 will be truncated to 255\nLine %d -> %d\n", line_count, number);
-                }
-                break;
+    if(batch_file != NULL){
+        if(mode != RUN_INTERPRETER || emit_asm || emit_c || profile || stats || cache || prerun_steps != 0 || file_name != NULL){
+            warning("--batch only runs the interpreter, other flags and input files except --cell-bits and --threads are ignored\n");
         }
+        return batch_progams(batch_file, cell_bytes, threads != 0 ? threads : cpu_count()) ? 0 : EXIT_FAILURE;
     }
 
+    if(file_name == NULL) fatal_error("No input file\n");
+    if(emit_asm && emit_c) warning("--emit-asm and --emit-c both passed, only the assembly is written\n");
+    if(emit_asm) mode = RUN_EMIT_ASM;
+    else if(emit_c) mode = RUN_EMIT_C;
+    if(profile && mode != RUN_INTERPRETER){
+        warning("--profile only works with the interpreter and is ignored\n");
+        profile = false;
+    }
+    if(stats && ((mode != RUN_INTERPRETER && mode != RUN_JIT) || profile)){
+        warning("--stats only works with the interpreter and --jit and is ignored\n");
+        stats = false;
+    }
+    if(prerun_steps != 0){
+        //the interpreter would only do the same work twice unless the result is cached
+        if(mode == RUN_JIT || mode == RUN_TIERED || profile || stats){
+            warning("--prerun does not work with --jit, --tiered, --profile or --stats and is ignored\n");
+            prerun_steps = 0;
+        } else if(mode == RUN_INTERPRETER && !cache){
+            warning("--prerun only helps the interpreter together with --cache and is ignored\n");
+            prerun_steps = 0;
+        }
+#if !defined(__x86_64__) || defined(_WIN64)
+        else if(mode != RUN_INTERPRETER && mode != RUN_EMIT_C){
+            warning("--prerun is only supported by the x86_64 Linux and Macos compiler and --emit-c and is ignored\n");
+            prerun_steps = 0;
+        }
+#endif
+    }
+     
 
-    if(bracket_stack.size != 0) fatal_error("No Final Closing Bracket\n");
+    //the source stays open for the profile report
+    Source source = source_open(file_name);
+    char cache_file[strlen(file_name) + 5];
+    sprintf(cache_file, "%s.bfc", file_name);
+    Source cache_data = {0};
+    Tokens program;
+    Prerun prerun = {0};
+    bool cached = cache && cache_load(cache_file, &source, &cache_data, &program, prerun_steps, cell_bytes, &prerun);
+    if(!cached){
+        Tokens tokens = lex_source_parallel(&source, threads != 0 ? threads : cpu_count());
+        program = optimize_tokens(&tokens, CLI_TAPE_CELLS);
+        tokens_delete(&tokens);
+        if(prerun_steps != 0) prerun = prerun_progam(&program, cell_bytes, prerun_steps);
+        if(cache) cache_write(cache_file, &source, &program, prerun_steps, cell_bytes, &prerun);
+    }
+    Prerun* start = prerun_steps != 0 ? &prerun : NULL;
+    uint64_t tape_size = tape_size_needed(&program, cell_bytes);
 
-    if(interpret){
-        interpret_progam(&tokens); 
+    switch (mode) {
+        case RUN_INTERPRETER:
+            if(profile) profile_progam(&program, cell_bytes, &source);
+            else if(stats) stats_progam(&program, cell_bytes, false);
+            else interpret_progam(&program, cell_bytes, start);
+            break;
+        case RUN_COMPILER:
+            compile_progam(file_name, output_name != NULL ? output_name : "a.out", tape_size, cell_bytes, &program, start);
+            break;
+        case RUN_JIT:
+            if(stats) stats_progam(&program, cell_bytes, true);
+            else jit_progam(&program, cell_bytes);
+            break;
+        case RUN_TIERED:
+            tiered_progam(&program, cell_bytes);
+            break;
+        case RUN_EMIT_ASM:
+            {
+            //without -o the assembly is written next to the source
+            char assembly_file[strlen(file_name) + 5];
+            sprintf(assembly_file, "%s.asm", file_name);
+            emit_assembly(output_name != NULL ? output_name : assembly_file, tape_size, cell_bytes, &program, start);
+            break;
+            }
+        case RUN_EMIT_C:
+            c_progam(file_name, output_name != NULL ? output_name : "a.out", tape_size, cell_bytes, &program, start);
+            break;
     }
-    else{
-        compile_progam(file_name, output_name, DEFAULT_PROGAM_SIZE, &tokens);
-    } 
 
-    tokens_delete(&tokens);
+    if(cached) source_close(&cache_data);
+    else{
+        tokens_delete(&program);
+        prerun_delete(&prerun);
+    }
+    source_close(&source);
 }
+#endif
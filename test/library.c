@@ -0,0 +1,124 @@
+//checks the error contract of libbrainfck behind make test
+//every case compiles a small program, runs it and compares the status and the output with what brainfck.h promises
+//prints one line per failed case and exits non zero when there was one
+
+#include <stdio.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+
+#include "brainfck.h"
+
+
+#define OUTPUT_CAPACITY 4096
+
+typedef struct {
+    const char* name;
+    const char* source; // NULL when it is built by the case itself
+    BrainfckOptions options;
+    const char* input;
+    BrainfckStatus compile_status;
+    BrainfckStatus run_status;
+    const char* output; // what the run writes before it stops, NULL to not check it
+} Case;
+
+uint32_t failures = 0;
+
+
+void fail(const char* name, const char* what, int expected, int got){
+    //the messages end in a newline already
+    const char* message = brainfck_error_message();
+    printf("FAIL %s: %s expected %d got %d (%.*s)\n", name, what, expected, got, (int)strcspn(message, "\n"), message);
+    failures++;
+}
+
+
+void run_case(Case* test, const char* source, size_t size){
+    BrainfckProgram* program = NULL;
+    BrainfckStatus status = brainfck_compile(source, size, &test->options, &program);
+    if(status != test->compile_status){
+        fail(test->name, "compile status", test->compile_status, status);
+        brainfck_free(program);
+        return;
+    }
+    if(status != BRAINFCK_OK){
+        if(program != NULL) fail(test->name, "program of a failed compile", 0, 1);
+        return;
+    }
+
+    uint8_t output[OUTPUT_CAPACITY];
+    //twice, a run that failed must not leave anything behind for the next one
+    for(uint32_t run = 0; run < 2; run++){
+        BrainfckIo io = {.output = output, .output_capacity = sizeof(output)};
+        if(test->input != NULL){
+            io.input = (const uint8_t*)test->input;
+            io.input_size = strlen(test->input);
+        }
+        status = brainfck_run(program, &io);
+        if(status != test->run_status) fail(test->name, "run status", test->run_status, status);
+        if(test->output != NULL && (io.output_size != strlen(test->output) || memcmp(output, test->output, io.output_size) != 0)){
+            fail(test->name, "output of size", (int)strlen(test->output), (int)io.output_size);
+        }
+    }
+    brainfck_free(program);
+}
+
+
+//head, then count times c, then tail
+char* repeated(const char* head, char c, size_t count, const char* tail){
+    size_t head_size = strlen(head);
+    char* source = malloc(head_size + count + strlen(tail) + 1);
+    if(source == NULL){
+        printf("Out of memory\n");
+        exit(EXIT_FAILURE);
+    }
+    strcpy(source, head);
+    memset(source + head_size, c, count);
+    strcpy(source + head_size + count, tail);
+    return source;
+}
+
+
+int main(void){
+    Case cases[] = {
+        {"hello", ">++++++++[<+++++++++>-]<.>++++[<+++++++>-]<+.", {0}, NULL, BRAINFCK_OK, BRAINFCK_OK, "He"},
+        {"echo", ",+[-.,+]", {0}, "abc", BRAINFCK_OK, BRAINFCK_OK, "abc"},
+        {"wide cells", "256+[>+<[-]]>.", {.cell_bits = 16}, NULL, BRAINFCK_OK, BRAINFCK_OK, "\x01"},
+        {"unclosed", "[[]", {0}, NULL, BRAINFCK_ERROR_SYNTAX, BRAINFCK_OK, NULL},
+        {"unopened", "+]", {0}, NULL, BRAINFCK_ERROR_SYNTAX, BRAINFCK_OK, NULL},
+        {"cell bits", "+", {.cell_bits = 12}, NULL, BRAINFCK_ERROR_ARGUMENT, BRAINFCK_OK, NULL},
+        {"underflow", "+.<+", {0}, NULL, BRAINFCK_OK, BRAINFCK_ERROR_TAPE_UNDERFLOW, "\x01"},
+        {"iterations", "+[.]", {.max_iterations = 3}, NULL, BRAINFCK_OK, BRAINFCK_ERROR_ITERATION_LIMIT, "\x01\x01\x01\x01"},
+        {"output", "+[.]", {.max_output = 5}, NULL, BRAINFCK_OK, BRAINFCK_ERROR_OUTPUT_LIMIT, "\x01\x01\x01\x01\x01"},
+        {"tape", "+[>+]", {.max_tape_bytes = 100000}, NULL, BRAINFCK_OK, BRAINFCK_ERROR_TAPE_LIMIT, ""},
+    };
+    for(uint32_t i = 0; i < sizeof(cases) / sizeof(cases[0]); i++){
+        run_case(&cases[i], cases[i].source, strlen(cases[i].source));
+    }
+
+    //a tape size that already is a multiple of 64KB is not rounded up any further
+    Case aligned = {"aligned tape", NULL, {.max_tape_bytes = 65536}, NULL, BRAINFCK_OK, BRAINFCK_ERROR_TAPE_LIMIT, ""};
+    char* source = repeated("", '>', 100000, "[-]+.");
+    run_case(&aligned, source, strlen(source));
+    free(source);
+    Case inside = {"inside tape", NULL, {.max_tape_bytes = 65536}, NULL, BRAINFCK_OK, BRAINFCK_OK, "\x01"};
+    source = repeated("", '>', 65535, "[-]+.");
+    run_case(&inside, source, strlen(source));
+    free(source);
+
+    //a loop that would be skipped on a zero cell still has to read that cell, and past the tape that fails
+    Case skipped = {"skipped read", NULL, {.max_tape_bytes = 65536}, NULL, BRAINFCK_OK, BRAINFCK_ERROR_TAPE_LIMIT, ""};
+    char* moves = repeated("", '>', 300000, "[.]");
+    source = repeated(moves, '<', 300000, "+.");
+    run_case(&skipped, source, strlen(source));
+    free(moves);
+    free(source);
+
+    if(failures != 0){
+        printf("%u failed\n", failures);
+        return EXIT_FAILURE;
+    }
+    printf("all passed\n");
+    return 0;
+}